@@ -2,6 +2,9 @@
 #include <vector>
 #include <chrono>
 #include <random>
+#include <thread>
+#include "reduction.h"
+#include "benchmark.h"
 
 const int SIZE = 4096;
 
@@ -48,6 +51,17 @@ long long sumMatrixOptimized(const std::vector<std::vector<int>>& matrix) {
     return sum;
 }
 
+// Median per-call time in microseconds from the adaptive harness in
+// week_1/phase1/benchmark.h; the last result is kept in `out`
+template <typename F, typename R>
+double timeMedianUs(F&& func, R& out) {
+    BenchmarkStats stats = run_benchmark([&]() {
+        out = func();
+        do_not_optimize(out);
+    });
+    return stats.median_ms * 1000.0;
+}
+
 int main() {
     // Generate a large random matrix
     std::vector<std::vector<int>> matrix(SIZE, std::vector<int>(SIZE));
@@ -77,10 +91,61 @@ int main() {
     std::cout << "Optimized Sum: " << optimized_sum << std::endl;
     std::cout << "Optimized Time: " << duration_optimized.count() << " microseconds" << std::endl;
 
+    // Reduction library on contiguous storage (warmup, then sampled until the
+    // median is stable)
+    DenseMatrix<int> dense = DenseMatrix<int>::from_nested(matrix);
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    long long basic_sum = 0, lib_sum = 0, lib_parallel_sum = 0;
+    double basic_us = timeMedianUs([&]() { return sumMatrixBasic(matrix); }, basic_sum);
+    double optimized_us = timeMedianUs([&]() { return sumMatrixOptimized(matrix); }, optimized_sum);
+    double lib_us = timeMedianUs([&]() { return static_cast<long long>(matrix_sum(dense)); }, lib_sum);
+    double parallel_us = timeMedianUs([&]() { return static_cast<long long>(matrix_sum(dense, threads)); }, lib_parallel_sum);
+
+    std::vector<std::int64_t> rows, cols;
+    double rows_us = timeMedianUs([&]() { return row_sums(dense); }, rows);
+    double cols_us = timeMedianUs([&]() { return col_sums(dense); }, cols);
+    int lo = 0, hi = 0;
+    double min_us = timeMedianUs([&]() { return matrix_min(dense); }, lo);
+    double max_us = timeMedianUs([&]() { return matrix_max(dense); }, hi);
+
+    long long rows_total = 0, cols_total = 0;
+    for (auto v : rows) rows_total += v;
+    for (auto v : cols) cols_total += v;
+    bool consistent = lib_sum == basic_sum && lib_parallel_sum == basic_sum && rows_total == basic_sum && cols_total == basic_sum;
+
+    std::cout << "\n--- Median of adaptive runs (microseconds) ---" << std::endl;
+    std::cout << "sumMatrixBasic:              " << basic_us << std::endl;
+    std::cout << "sumMatrixOptimized:          " << optimized_us << std::endl;
+    std::cout << "matrix_sum (SIMD lanes):     " << lib_us << std::endl;
+    std::cout << "matrix_sum (" << threads << " threads):      " << parallel_us << std::endl;
+    std::cout << "row_sums:                    " << rows_us << std::endl;
+    std::cout << "col_sums:                    " << cols_us << std::endl;
+    std::cout << "matrix_min / matrix_max:     " << min_us << " / " << max_us << "  (" << lo << ", " << hi << ")" << std::endl;
+    std::cout << "Mean: " << matrix_mean(dense, threads) << std::endl;
+    std::cout << (consistent ? "All sums agree." : "MISMATCH between reduction results!") << std::endl;
+
+    // Floating-point sums are order dependent; the parallel sum must still be
+    // bit-identical for every thread count
+    DenseMatrix<double> prices(SIZE, SIZE);
+    std::uniform_real_distribution<> price_distrib(90.0, 110.0);
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        prices.data()[i] = price_distrib(gen);
+    }
+    double reference = matrix_sum(prices, 1);
+    bool deterministic = true;
+    for (unsigned t : {2u, 3u, threads}) {
+        deterministic &= matrix_sum(prices, t) == reference;
+    }
+    std::cout << "Parallel double sum deterministic across thread counts: " << (deterministic ? "yes" : "NO") << std::endl;
+    if (!consistent || !deterministic) {
+        return 1;
+    }
+
     return 0;
 }
 
-// g++ -O3 -march=native -std=c++20 -o matrix_sum matrix_sum.cpp
+// g++ -O3 -march=native -std=c++20 -pthread -I../phase1 -o matrix_sum matrix_sum.cpp reduction.cpp ../phase1/benchmark.cpp
 
 // On average, the optimized version should be faster than the basic version by about 150 microseconds on my hardware, which meets my target execution time.
 // Example output:
@@ -0,0 +1,308 @@
+#include "reduction.h"
+#include <algorithm>
+#include <thread>
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Elements per parallel_sum chunk: fixed so the combine order never depends
+// on the thread count (64K ints = 256KB, about one L2)
+constexpr std::size_t kChunk = 64 * 1024;
+
+void check_non_empty(std::size_t n) {
+    if (n == 0) {
+        throw std::invalid_argument("Cannot reduce an empty range.");
+    }
+}
+
+// Shared skeleton: kReduceLanes accumulators updated with `step`, folded with
+// `combine`, then the tail. Step/combine are simple enough to vectorise.
+template <typename Acc, typename T, typename Step, typename Combine>
+Acc reduce_lanes(const T* data, std::size_t n, Acc init, Step step, Combine combine) {
+    Acc lanes[kReduceLanes];
+    std::fill(lanes, lanes + kReduceLanes, init);
+
+    std::size_t i = 0;
+    for (; i + kReduceLanes <= n; i += kReduceLanes) {
+        for (int l = 0; l < kReduceLanes; ++l) {
+            lanes[l] = step(lanes[l], data[i + l]);
+        }
+    }
+    // Pairwise fold keeps the floating-point rounding tree balanced
+    for (int width = kReduceLanes / 2; width > 0; width /= 2) {
+        for (int l = 0; l < width; ++l) {
+            lanes[l] = combine(lanes[l], lanes[l + width]);
+        }
+    }
+    Acc result = lanes[0];
+    for (; i < n; ++i) {
+        result = step(result, data[i]);
+    }
+    return result;
+}
+
+#if defined(__AVX__)
+// Floating-point min/max do not auto-vectorise under strict IEEE rules (the
+// compiler will not turn `v < a ? v : a` into a vector min across a loop-carried
+// accumulator), so they are written out with four vector accumulators.
+// _mm256_min_p*(v, a) is exactly `v < a ? v : a`, matching the scalar path.
+struct AvxDouble {
+    using V = __m256d;
+    static constexpr int width = 4;
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static V broadcast(double x) { return _mm256_set1_pd(x); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+};
+
+struct AvxFloat {
+    using V = __m256;
+    static constexpr int width = 8;
+    static V load(const float* p) { return _mm256_loadu_ps(p); }
+    static V broadcast(float x) { return _mm256_set1_ps(x); }
+    static V min(V a, V b) { return _mm256_min_ps(a, b); }
+    static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    static void store(float* p, V v) { _mm256_storeu_ps(p, v); }
+};
+
+template <typename Ops, bool IsMin, typename T>
+T min_max_avx(const T* data, std::size_t n) {
+    using V = typename Ops::V;
+    constexpr int W = Ops::width;
+    auto pick = [](V v, V a) { return IsMin ? Ops::min(v, a) : Ops::max(v, a); };
+
+    V acc[4] = {Ops::broadcast(data[0]), Ops::broadcast(data[0]), Ops::broadcast(data[0]), Ops::broadcast(data[0])};
+    std::size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W) {
+        for (int k = 0; k < 4; ++k) {
+            acc[k] = pick(Ops::load(data + i + k * W), acc[k]);
+        }
+    }
+    acc[0] = pick(acc[0], pick(acc[1], pick(acc[2], acc[3])));
+
+    T lanes[W];
+    Ops::store(lanes, acc[0]);
+    T result = lanes[0];
+    for (int l = 1; l < W; ++l) {
+        result = IsMin ? (lanes[l] < result ? lanes[l] : result) : (lanes[l] > result ? lanes[l] : result);
+    }
+    for (; i < n; ++i) {
+        result = IsMin ? (data[i] < result ? data[i] : result) : (data[i] > result ? data[i] : result);
+    }
+    return result;
+}
+#endif
+
+unsigned resolve_threads(unsigned threads, std::size_t chunks) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return static_cast<unsigned>(std::min<std::size_t>(threads, chunks));
+}
+
+// Column accumulators: acc[j] = step(acc[j], row[j]) for rows first_row..end
+template <typename Acc, typename T, typename Step>
+std::vector<Acc> reduce_columns(const DenseMatrix<T>& m, std::vector<Acc> acc, int first_row, Step step) {
+    for (int i = first_row; i < m.rows(); ++i) {
+        const T* row = m.row(i);
+        Acc* out = acc.data();
+        for (int j = 0; j < m.cols(); ++j) {
+            out[j] = step(out[j], row[j]);
+        }
+    }
+    return acc;
+}
+
+} // namespace
+
+template <typename T>
+sum_t<T> reduce_sum(const T* data, std::size_t n) {
+    using Acc = sum_t<T>;
+    return reduce_lanes<Acc>(data, n, Acc(0),
+                             [](Acc a, T v) { return a + static_cast<Acc>(v); },
+                             [](Acc a, Acc b) { return a + b; });
+}
+
+template <typename T>
+T reduce_min(const T* data, std::size_t n) {
+    check_non_empty(n);
+#if defined(__AVX__)
+    if constexpr (std::is_same_v<T, double>) {
+        return min_max_avx<AvxDouble, true>(data, n);
+    } else if constexpr (std::is_same_v<T, float>) {
+        return min_max_avx<AvxFloat, true>(data, n);
+    }
+#endif
+    return reduce_lanes<T>(data, n, data[0],
+                           [](T a, T v) { return v < a ? v : a; },
+                           [](T a, T b) { return b < a ? b : a; });
+}
+
+template <typename T>
+T reduce_max(const T* data, std::size_t n) {
+    check_non_empty(n);
+#if defined(__AVX__)
+    if constexpr (std::is_same_v<T, double>) {
+        return min_max_avx<AvxDouble, false>(data, n);
+    } else if constexpr (std::is_same_v<T, float>) {
+        return min_max_avx<AvxFloat, false>(data, n);
+    }
+#endif
+    return reduce_lanes<T>(data, n, data[0],
+                           [](T a, T v) { return v > a ? v : a; },
+                           [](T a, T b) { return b > a ? b : a; });
+}
+
+template <typename T>
+double reduce_mean(const T* data, std::size_t n) {
+    check_non_empty(n);
+    return static_cast<double>(reduce_sum(data, n)) / static_cast<double>(n);
+}
+
+template <typename T>
+sum_t<T> parallel_sum(const T* data, std::size_t n, unsigned threads) {
+    std::size_t chunks = (n + kChunk - 1) / kChunk;
+    threads = resolve_threads(threads, chunks);
+    if (threads <= 1) {
+        // Same chunking as the threaded path so results match exactly
+        sum_t<T> total = 0;
+        for (std::size_t c = 0; c < chunks; ++c) {
+            std::size_t begin = c * kChunk;
+            total += reduce_sum(data + begin, std::min(kChunk, n - begin));
+        }
+        return total;
+    }
+
+    std::vector<sum_t<T>> partials(chunks);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (std::size_t c = t; c < chunks; c += threads) {
+                std::size_t begin = c * kChunk;
+                partials[c] = reduce_sum(data + begin, std::min(kChunk, n - begin));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    sum_t<T> total = 0;
+    for (sum_t<T> partial : partials) {
+        total += partial;
+    }
+    return total;
+}
+
+template <typename T>
+sum_t<T> matrix_sum(const DenseMatrix<T>& m, unsigned threads) {
+    return parallel_sum(m.data(), m.size(), threads);
+}
+
+template <typename T>
+T matrix_min(const DenseMatrix<T>& m) {
+    return reduce_min(m.data(), m.size());
+}
+
+template <typename T>
+T matrix_max(const DenseMatrix<T>& m) {
+    return reduce_max(m.data(), m.size());
+}
+
+template <typename T>
+double matrix_mean(const DenseMatrix<T>& m, unsigned threads) {
+    check_non_empty(m.size());
+    return static_cast<double>(matrix_sum(m, threads)) / static_cast<double>(m.size());
+}
+
+template <typename T>
+std::vector<sum_t<T>> row_sums(const DenseMatrix<T>& m) {
+    std::vector<sum_t<T>> out(m.rows());
+    for (int i = 0; i < m.rows(); ++i) {
+        out[i] = reduce_sum(m.row(i), m.cols());
+    }
+    return out;
+}
+
+template <typename T>
+std::vector<T> row_mins(const DenseMatrix<T>& m) {
+    std::vector<T> out(m.rows());
+    for (int i = 0; i < m.rows(); ++i) {
+        out[i] = reduce_min(m.row(i), m.cols());
+    }
+    return out;
+}
+
+template <typename T>
+std::vector<T> row_maxs(const DenseMatrix<T>& m) {
+    std::vector<T> out(m.rows());
+    for (int i = 0; i < m.rows(); ++i) {
+        out[i] = reduce_max(m.row(i), m.cols());
+    }
+    return out;
+}
+
+template <typename T>
+std::vector<double> row_means(const DenseMatrix<T>& m) {
+    std::vector<double> out(m.rows());
+    for (int i = 0; i < m.rows(); ++i) {
+        out[i] = reduce_mean(m.row(i), m.cols());
+    }
+    return out;
+}
+
+template <typename T>
+std::vector<sum_t<T>> col_sums(const DenseMatrix<T>& m) {
+    using Acc = sum_t<T>;
+    return reduce_columns(m, std::vector<Acc>(m.cols(), Acc(0)), 0, [](Acc a, T v) { return a + static_cast<Acc>(v); });
+}
+
+template <typename T>
+std::vector<T> col_mins(const DenseMatrix<T>& m) {
+    check_non_empty(m.rows());
+    return reduce_columns(m, std::vector<T>(m.row(0), m.row(0) + m.cols()), 1, [](T a, T v) { return v < a ? v : a; });
+}
+
+template <typename T>
+std::vector<T> col_maxs(const DenseMatrix<T>& m) {
+    check_non_empty(m.rows());
+    return reduce_columns(m, std::vector<T>(m.row(0), m.row(0) + m.cols()), 1, [](T a, T v) { return v > a ? v : a; });
+}
+
+template <typename T>
+std::vector<double> col_means(const DenseMatrix<T>& m) {
+    check_non_empty(m.rows());
+    std::vector<sum_t<T>> sums = col_sums(m);
+    std::vector<double> out(sums.size());
+    for (std::size_t j = 0; j < sums.size(); ++j) {
+        out[j] = static_cast<double>(sums[j]) / m.rows();
+    }
+    return out;
+}
+
+#define INSTANTIATE_REDUCTIONS(T)                                                   \
+    template sum_t<T> reduce_sum<T>(const T*, std::size_t);                         \
+    template T reduce_min<T>(const T*, std::size_t);                                \
+    template T reduce_max<T>(const T*, std::size_t);                                \
+    template double reduce_mean<T>(const T*, std::size_t);                          \
+    template sum_t<T> parallel_sum<T>(const T*, std::size_t, unsigned);             \
+    template sum_t<T> matrix_sum<T>(const DenseMatrix<T>&, unsigned);               \
+    template T matrix_min<T>(const DenseMatrix<T>&);                                \
+    template T matrix_max<T>(const DenseMatrix<T>&);                                \
+    template double matrix_mean<T>(const DenseMatrix<T>&, unsigned);                \
+    template std::vector<sum_t<T>> row_sums<T>(const DenseMatrix<T>&);              \
+    template std::vector<T> row_mins<T>(const DenseMatrix<T>&);                     \
+    template std::vector<T> row_maxs<T>(const DenseMatrix<T>&);                     \
+    template std::vector<double> row_means<T>(const DenseMatrix<T>&);               \
+    template std::vector<sum_t<T>> col_sums<T>(const DenseMatrix<T>&);              \
+    template std::vector<T> col_mins<T>(const DenseMatrix<T>&);                     \
+    template std::vector<T> col_maxs<T>(const DenseMatrix<T>&);                     \
+    template std::vector<double> col_means<T>(const DenseMatrix<T>&);
+
+INSTANTIATE_REDUCTIONS(int)
+INSTANTIATE_REDUCTIONS(float)
+INSTANTIATE_REDUCTIONS(double)
@@ -0,0 +1,123 @@
+#ifndef REDUCTION_H
+#define REDUCTION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Reductions over contiguous arrays and row-major matrices.
+// Every kernel keeps several independent accumulators (kReduceLanes of them)
+// so the loop carries no single dependency chain and the compiler can keep
+// them in SIMD registers; they are folded together once at the end. Integer
+// sums accumulate in int64_t, floating-point sums in double.
+// Instantiated for int, float and double.
+
+constexpr int kReduceLanes = 16;
+
+template <typename T>
+using sum_t = std::conditional_t<std::is_integral_v<T>, std::int64_t, double>;
+
+// Dense row-major matrix on one contiguous allocation
+template <typename T>
+class DenseMatrix {
+public:
+    DenseMatrix() = default;
+    DenseMatrix(int rows, int cols) : rows_(rows), cols_(cols) {
+        if (rows < 0 || cols < 0) {
+            throw std::invalid_argument("Matrix dimensions must be non-negative.");
+        }
+        data_.resize(static_cast<std::size_t>(rows) * cols);
+    }
+
+    // Copies a vector-of-rows matrix; all rows must have the same length
+    static DenseMatrix from_nested(const std::vector<std::vector<T>>& nested) {
+        int cols = nested.empty() ? 0 : static_cast<int>(nested[0].size());
+        DenseMatrix m(static_cast<int>(nested.size()), cols);
+        for (int i = 0; i < m.rows(); ++i) {
+            if (static_cast<int>(nested[i].size()) != cols) {
+                throw std::invalid_argument("Rows must all have the same length.");
+            }
+            std::copy(nested[i].begin(), nested[i].end(), m.row(i));
+        }
+        return m;
+    }
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    std::size_t size() const { return data_.size(); }
+    T* data() { return data_.data(); }
+    const T* data() const { return data_.data(); }
+    T* row(int i) { return data_.data() + static_cast<std::size_t>(i) * cols_; }
+    const T* row(int i) const { return data_.data() + static_cast<std::size_t>(i) * cols_; }
+    T& operator()(int i, int j) { return row(i)[j]; }
+    const T& operator()(int i, int j) const { return row(i)[j]; }
+
+private:
+    std::vector<T> data_;
+    int rows_ = 0;
+    int cols_ = 0;
+};
+
+// --- Flat arrays (min/max/mean of an empty range throw) ---
+template <typename T>
+sum_t<T> reduce_sum(const T* data, std::size_t n);
+
+template <typename T>
+T reduce_min(const T* data, std::size_t n);
+
+template <typename T>
+T reduce_max(const T* data, std::size_t n);
+
+template <typename T>
+double reduce_mean(const T* data, std::size_t n);
+
+// Splits the range into fixed-size chunks whose partial sums are combined in
+// chunk order, so the result is bit-identical for any thread count.
+// threads == 0 uses hardware_concurrency().
+template <typename T>
+sum_t<T> parallel_sum(const T* data, std::size_t n, unsigned threads = 0);
+
+// --- Whole matrix ---
+template <typename T>
+sum_t<T> matrix_sum(const DenseMatrix<T>& m, unsigned threads = 1);
+
+template <typename T>
+T matrix_min(const DenseMatrix<T>& m);
+
+template <typename T>
+T matrix_max(const DenseMatrix<T>& m);
+
+template <typename T>
+double matrix_mean(const DenseMatrix<T>& m, unsigned threads = 1);
+
+// --- Per row (one result per row) and per column (one per column) ---
+template <typename T>
+std::vector<sum_t<T>> row_sums(const DenseMatrix<T>& m);
+
+template <typename T>
+std::vector<T> row_mins(const DenseMatrix<T>& m);
+
+template <typename T>
+std::vector<T> row_maxs(const DenseMatrix<T>& m);
+
+template <typename T>
+std::vector<double> row_means(const DenseMatrix<T>& m);
+
+// Column reductions stream the matrix row by row into a vector of column
+// accumulators, so memory is still read sequentially
+template <typename T>
+std::vector<sum_t<T>> col_sums(const DenseMatrix<T>& m);
+
+template <typename T>
+std::vector<T> col_mins(const DenseMatrix<T>& m);
+
+template <typename T>
+std::vector<T> col_maxs(const DenseMatrix<T>& m);
+
+template <typename T>
+std::vector<double> col_means(const DenseMatrix<T>& m);
+
+#endif
@@ -4,8 +4,27 @@
 #include <cstdlib>
 #include <memory>
 #include <stdexcept>
+#include <vector>
+#include "huge_pages.h"
 
-template <typename T, std::size_t Alignment = 64>
+// Default page policy: ordinary heap memory via posix_memalign
+struct HeapPages {
+    static void* allocate(std::size_t bytes, std::size_t alignment) {
+        void* ptr = nullptr;
+        if (posix_memalign(&ptr, alignment, bytes) != 0) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    static void deallocate(void* ptr, std::size_t) noexcept {
+        std::free(ptr);
+    }
+};
+
+// Pages picks where the memory comes from: HeapPages, or HugePages<...> from
+// huge_pages.h to put the buffer on 2MB pages
+template <typename T, std::size_t Alignment = 64, typename Pages = HeapPages>
 class AlignedAllocator {
 public:
     using value_type = T;
@@ -13,27 +32,32 @@ public:
     AlignedAllocator() noexcept = default;
 
     template <typename U>
-    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+    AlignedAllocator(const AlignedAllocator<U, Alignment, Pages>&) noexcept {}
 
     T* allocate(std::size_t n) {
-        void* ptr = nullptr;
-        if (posix_memalign(&ptr, Alignment, n * sizeof(T)) != 0) {
-            throw std::bad_alloc();
-        }
-        return static_cast<T*>(ptr);
+        return static_cast<T*>(Pages::allocate(n * sizeof(T), Alignment));
     }
 
-    void deallocate(T* ptr, std::size_t) noexcept {
-        std::free(ptr);
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        Pages::deallocate(ptr, n * sizeof(T));
     }
 
     template <typename U>
     struct rebind {
-        using other = AlignedAllocator<U, Alignment>;
+        using other = AlignedAllocator<U, Alignment, Pages>;
     };
 
     bool operator==(const AlignedAllocator&) const noexcept { return true; }
     bool operator!=(const AlignedAllocator&) const noexcept { return false; }
 };
 
+template <typename T, typename Pages = HeapPages>
+using AlignedVector = std::vector<T, AlignedAllocator<T, 64, Pages>>;
+
+template <typename T>
+using HugePageAllocator = AlignedAllocator<T, 64, HugePages<>>;
+
+template <typename T>
+using HugePageVector = AlignedVector<T, HugePages<>>;
+
 #endif // ALIGNMENT_H
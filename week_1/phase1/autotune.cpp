@@ -0,0 +1,151 @@
+#include "autotune.h"
+#include "benchmark.h"
+#include "cpu_info.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+const int candidate_blocks[] = {16, 32, 48, 64, 96, 128, 192, 256};
+
+const char* order_name(TileLoopOrder order) {
+    return order == TileLoopOrder::IKJ ? "ikj" : "kij";
+}
+
+bool parse_order(const std::string& name, TileLoopOrder& order) {
+    if (name == "ikj") { order = TileLoopOrder::IKJ; return true; }
+    if (name == "kij") { order = TileLoopOrder::KIJ; return true; }
+    return false;
+}
+
+std::string format_config(const TileConfig& c) {
+    std::ostringstream out;
+    out << c.block_i << " " << c.block_j << " " << c.block_k << " " << order_name(c.order);
+    return out.str();
+}
+
+} // namespace
+
+TileConfig autotune_tile_config(int n, int runs, bool verbose) {
+    if (n <= 0 || runs <= 0) {
+        throw std::invalid_argument("Autotune size and runs must be positive.");
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> distrib(0.0, 1.0);
+    std::vector<double> A(n * n), B(n * n), C(n * n);
+    for (auto& v : A) v = distrib(gen);
+    for (auto& v : B) v = distrib(gen);
+
+    auto measure = [&](const TileConfig& config) {
+        auto timing = time_function_ms([&]() {
+            multiply_mm_tiled(A.data(), n, n, B.data(), n, n, C.data(), config);
+        }, runs);
+        if (verbose) {
+            std::cout << "  tile " << format_config(config) << ": " << timing.first << " ms" << std::endl;
+        }
+        return timing.first;
+    };
+
+    TileConfig best;
+    double best_ms = measure(best);
+
+    int TileConfig::* levels[] = {&TileConfig::block_k, &TileConfig::block_j, &TileConfig::block_i};
+    for (int pass = 0; pass < 2; ++pass) {
+        for (auto level : levels) {
+            for (int size : candidate_blocks) {
+                if (size == best.*level) continue;
+                TileConfig trial = best;
+                trial.*level = size;
+                double ms = measure(trial);
+                if (ms < best_ms) {
+                    best_ms = ms;
+                    best = trial;
+                }
+            }
+        }
+    }
+
+    TileConfig trial = best;
+    trial.order = best.order == TileLoopOrder::IKJ ? TileLoopOrder::KIJ : TileLoopOrder::IKJ;
+    if (measure(trial) < best_ms) {
+        best = trial;
+    }
+    return best;
+}
+
+std::string tile_cache_path() {
+    const char* env = std::getenv("MATRIX_OPS_TUNE_CACHE");
+    return (env && *env) ? env : "matrix_ops_tuning.cache";
+}
+
+bool load_tile_config(const std::string& path, const std::string& cpu_model, TileConfig& config) {
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos || line.substr(0, tab) != cpu_model) {
+            continue;
+        }
+        std::istringstream fields(line.substr(tab + 1));
+        TileConfig parsed;
+        std::string order;
+        if (fields >> parsed.block_i >> parsed.block_j >> parsed.block_k >> order
+            && parse_order(order, parsed.order)
+            && parsed.block_i > 0 && parsed.block_j > 0 && parsed.block_k > 0) {
+            config = parsed;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool save_tile_config(const std::string& path, const std::string& cpu_model, const TileConfig& config) {
+    // Keep entries for other CPU models so one cache can be shared across the fleet
+    std::vector<std::string> lines;
+    {
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.rfind(cpu_model + "\t", 0) != 0 && !line.empty()) {
+                lines.push_back(line);
+            }
+        }
+    }
+    lines.push_back(cpu_model + "\t" + format_config(config));
+
+    std::ofstream out(path, std::ios::trunc);
+    for (const auto& line : lines) {
+        out << line << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+TileConfig init_tile_config(bool retune, bool verbose) {
+    const std::string& model = cpu_info().model;
+    const std::string path = tile_cache_path();
+
+    TileConfig config;
+    if (!retune && load_tile_config(path, model, config)) {
+        if (verbose) {
+            std::cout << "Loaded tile config " << format_config(config) << " from " << path << std::endl;
+        }
+    } else {
+        if (verbose) {
+            std::cout << "Autotuning tile config for \"" << model << "\"..." << std::endl;
+        }
+        config = autotune_tile_config(384, 3, verbose);
+        if (!save_tile_config(path, model, config)) {
+            std::cerr << "Warning: could not write tile cache " << path << std::endl;
+        }
+        if (verbose) {
+            std::cout << "Tuned tile config " << format_config(config) << " saved to " << path << std::endl;
+        }
+    }
+    set_tile_config(config);
+    return config;
+}
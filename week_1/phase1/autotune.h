@@ -0,0 +1,22 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include "matrix_ops.h"
+#include <string>
+
+// Sweeps TileConfig for multiply_mm_optimized on an n x n problem: each block
+// size is swept in turn with the others held fixed (coordinate descent, two
+// passes), then both loop orders are tried. Timing uses time_function_ms.
+TileConfig autotune_tile_config(int n = 384, int runs = 3, bool verbose = false);
+
+// On-disk cache: one line per CPU model, "<model>\t<block_i> <block_j> <block_k> <order>".
+// The path comes from $MATRIX_OPS_TUNE_CACHE, else ./matrix_ops_tuning.cache
+std::string tile_cache_path();
+bool load_tile_config(const std::string& path, const std::string& cpu_model, TileConfig& config);
+bool save_tile_config(const std::string& path, const std::string& cpu_model, const TileConfig& config);
+
+// Startup hook: installs the cached configuration for this CPU, tuning and
+// saving it first if there is none (or if retune is set). Returns what was installed.
+TileConfig init_tile_config(bool retune = false, bool verbose = false);
+
+#endif
@@ -0,0 +1,366 @@
+#include "batched_gemm.h"
+#include "cpu_info.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BATCH_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+// Everything below the ISA entry points is force-inlined, so each entry point
+// gets its own copy of the kernels compiled for its target
+#define BATCH_INLINE inline __attribute__((always_inline))
+
+namespace {
+
+inline void check_null(const void* ptr, const char* name) {
+    if (!ptr) {
+        throw std::invalid_argument(std::string(name) + " cannot be null.");
+    }
+}
+
+void check_dims(int count, int m, int k, int n) {
+    if (count < 0 || m <= 0 || k <= 0 || n <= 0) {
+        throw std::invalid_argument("Invalid dimensions for batched matrix multiplication.");
+    }
+}
+
+// --- Per-product kernels ---
+
+// Vector operations for the fixed-size kernel. GCC's auto-vectoriser turns
+// the fully unrolled 8/16 loops into shuffle-heavy reductions over k, so the
+// vector width is spelled out instead.
+struct ScalarOps {
+    using V = double;
+    static constexpr int width = 1;
+    static V zero() { return 0.0; }
+    static V broadcast(double x) { return x; }
+    static V load(const double* p) { return *p; }
+    static V fma(V a, V b, V c) { return a * b + c; }
+    static void store(double* p, V v) { *p = v; }
+};
+
+#ifdef BATCH_HAVE_X86
+// These helpers return __m256d/__m512d, but they are only ever inlined into
+// functions compiled for the matching target, so the generic-ABI warning on
+// them (and on their calls in small_gemm_fixed) does not apply
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+struct Avx2Ops {
+    using V = __m256d;
+    static constexpr int width = 4;
+    __attribute__((target("avx2,fma"))) static V zero() { return _mm256_setzero_pd(); }
+    __attribute__((target("avx2,fma"))) static V broadcast(double x) { return _mm256_set1_pd(x); }
+    __attribute__((target("avx2,fma"))) static V load(const double* p) { return _mm256_loadu_pd(p); }
+    __attribute__((target("avx2,fma"))) static V fma(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }
+    __attribute__((target("avx2,fma"))) static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+};
+
+struct Avx512Ops {
+    using V = __m512d;
+    static constexpr int width = 8;
+    __attribute__((target("avx512f"))) static V zero() { return _mm512_setzero_pd(); }
+    __attribute__((target("avx512f"))) static V broadcast(double x) { return _mm512_set1_pd(x); }
+    __attribute__((target("avx512f"))) static V load(const double* p) { return _mm512_loadu_pd(p); }
+    __attribute__((target("avx512f"))) static V fma(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+    __attribute__((target("avx512f"))) static void store(double* p, V v) { _mm512_storeu_pd(p, v); }
+};
+#endif
+
+// R rows of C stay in R * N / width registers for the whole k loop; R is
+// chosen so at least eight independent FMA chains are in flight
+template <typename Ops, int M, int K, int N>
+BATCH_INLINE void small_gemm_fixed(const double* __restrict A, const double* __restrict B, double* __restrict C) {
+    using V = typename Ops::V;
+    constexpr int VN = N / Ops::width;
+    constexpr int R = VN >= 8 ? 1 : 8 / VN;
+    static_assert(N % Ops::width == 0 && M % R == 0, "unsupported fixed GEMM size");
+
+    for (int i = 0; i < M; i += R) {
+        V acc[R][VN];
+        for (int r = 0; r < R; ++r) {
+            for (int v = 0; v < VN; ++v) {
+                acc[r][v] = Ops::zero();
+            }
+        }
+        for (int p = 0; p < K; ++p) {
+            const double* b = B + p * N;
+            for (int r = 0; r < R; ++r) {
+                V a = Ops::broadcast(A[(i + r) * K + p]);
+                for (int v = 0; v < VN; ++v) {
+                    acc[r][v] = Ops::fma(a, Ops::load(b + v * Ops::width), acc[r][v]);
+                }
+            }
+        }
+        for (int r = 0; r < R; ++r) {
+            for (int v = 0; v < VN; ++v) {
+                Ops::store(C + (i + r) * N + v * Ops::width, acc[r][v]);
+            }
+        }
+    }
+}
+
+#ifdef BATCH_HAVE_X86
+#pragma GCC diagnostic pop
+#endif
+
+BATCH_INLINE void small_gemm_dynamic(const double* __restrict A, const double* __restrict B, double* __restrict C,
+                                     int m, int k, int n) {
+    for (int i = 0; i < m; ++i) {
+        double* c = C + i * n;
+        std::fill(c, c + n, 0.0);
+        for (int p = 0; p < k; ++p) {
+            const double a = A[i * k + p];
+            const double* b = B + p * n;
+            for (int j = 0; j < n; ++j) {
+                c[j] += a * b[j];
+            }
+        }
+    }
+}
+
+struct StridedBatch {
+    const double* A;
+    std::ptrdiff_t strideA;
+    const double* B;
+    std::ptrdiff_t strideB;
+    double* C;
+    std::ptrdiff_t strideC;
+
+    const double* a(int b) const { return A + b * strideA; }
+    const double* b(int b) const { return B + b * strideB; }
+    double* c(int b) const { return C + b * strideC; }
+};
+
+struct TripleBatch {
+    const GemmTriple* items;
+
+    const double* a(int b) const { return items[b].A; }
+    const double* b(int b) const { return items[b].B; }
+    double* c(int b) const { return items[b].C; }
+};
+
+template <typename Ops, int N, typename Batch>
+BATCH_INLINE void run_square(const Batch& batch, int count) {
+    for (int b = 0; b < count; ++b) {
+        small_gemm_fixed<Ops, N, N, N>(batch.a(b), batch.b(b), batch.c(b));
+    }
+}
+
+template <typename Ops, typename Batch>
+BATCH_INLINE void run_batch(const Batch& batch, int count, int m, int k, int n) {
+    if (m == k && k == n) {
+        switch (n) {
+            case 8: run_square<Ops, 8>(batch, count); return;
+            case 16: run_square<Ops, 16>(batch, count); return;
+            case 24: run_square<Ops, 24>(batch, count); return;
+            case 32: run_square<Ops, 32>(batch, count); return;
+            default: break;
+        }
+    }
+    for (int b = 0; b < count; ++b) {
+        small_gemm_dynamic(batch.a(b), batch.b(b), batch.c(b), m, k, n);
+    }
+}
+
+// --- Interleaved kernel: the innermost loop runs across the kBatchLanes matrices ---
+
+constexpr int W = kBatchLanes;
+
+BATCH_INLINE void interleaved_group(const double* __restrict A, const double* __restrict B, double* __restrict C,
+                                    int m, int k, int n) {
+    for (int i = 0; i < m; ++i) {
+        int j = 0;
+        // Four columns at a time so each A load feeds four FMAs
+        for (; j + 4 <= n; j += 4) {
+            double acc[4][W] = {};
+            for (int p = 0; p < k; ++p) {
+                const double* a = A + (i * k + p) * W;
+                const double* b = B + (p * n + j) * W;
+                for (int jj = 0; jj < 4; ++jj) {
+                    for (int l = 0; l < W; ++l) {
+                        acc[jj][l] += a[l] * b[jj * W + l];
+                    }
+                }
+            }
+            for (int jj = 0; jj < 4; ++jj) {
+                std::copy(acc[jj], acc[jj] + W, C + (i * n + j + jj) * W);
+            }
+        }
+        for (; j < n; ++j) {
+            double acc[W] = {};
+            for (int p = 0; p < k; ++p) {
+                const double* a = A + (i * k + p) * W;
+                const double* b = B + (p * n + j) * W;
+                for (int l = 0; l < W; ++l) {
+                    acc[l] += a[l] * b[l];
+                }
+            }
+            std::copy(acc, acc + W, C + (i * n + j) * W);
+        }
+    }
+}
+
+BATCH_INLINE void run_interleaved(const double* A, const double* B, double* C, int groups, int m, int k, int n) {
+    const std::ptrdiff_t sa = static_cast<std::ptrdiff_t>(m) * k * W;
+    const std::ptrdiff_t sb = static_cast<std::ptrdiff_t>(k) * n * W;
+    const std::ptrdiff_t sc = static_cast<std::ptrdiff_t>(m) * n * W;
+    for (int g = 0; g < groups; ++g) {
+        interleaved_group(A + g * sa, B + g * sb, C + g * sc, m, k, n);
+    }
+}
+
+// --- ISA entry points ---
+
+template <typename Batch>
+void batch_scalar(const Batch& batch, int count, int m, int k, int n) {
+    run_batch<ScalarOps>(batch, count, m, k, n);
+}
+
+void interleaved_scalar(const double* A, const double* B, double* C, int groups, int m, int k, int n) {
+    run_interleaved(A, B, C, groups, m, k, n);
+}
+
+#ifdef BATCH_HAVE_X86
+template <typename Batch>
+__attribute__((target("avx2,fma")))
+void batch_avx2(const Batch& batch, int count, int m, int k, int n) {
+    run_batch<Avx2Ops>(batch, count, m, k, n);
+}
+
+__attribute__((target("avx2,fma")))
+void interleaved_avx2(const double* A, const double* B, double* C, int groups, int m, int k, int n) {
+    run_interleaved(A, B, C, groups, m, k, n);
+}
+
+template <typename Batch>
+__attribute__((target("avx512f")))
+void batch_avx512(const Batch& batch, int count, int m, int k, int n) {
+    run_batch<Avx512Ops>(batch, count, m, k, n);
+}
+
+__attribute__((target("avx512f")))
+void interleaved_avx512(const double* A, const double* B, double* C, int groups, int m, int k, int n) {
+    run_interleaved(A, B, C, groups, m, k, n);
+}
+#endif
+
+enum class BatchIsa { Scalar, Avx2, Avx512 };
+
+BatchIsa select_isa() {
+#ifdef BATCH_HAVE_X86
+    const CpuInfo& cpu = cpu_info();
+    if (cpu.has_avx512f) {
+        return BatchIsa::Avx512;
+    }
+    if (cpu.has_avx2 && cpu.has_fma) {
+        return BatchIsa::Avx2;
+    }
+#endif
+    return BatchIsa::Scalar;
+}
+
+BatchIsa active_isa() {
+    static const BatchIsa isa = select_isa();
+    return isa;
+}
+
+template <typename Batch>
+void dispatch_batch(const Batch& batch, int count, int m, int k, int n) {
+    switch (active_isa()) {
+#ifdef BATCH_HAVE_X86
+        case BatchIsa::Avx512: batch_avx512(batch, count, m, k, n); return;
+        case BatchIsa::Avx2: batch_avx2(batch, count, m, k, n); return;
+#endif
+        default: batch_scalar(batch, count, m, k, n); return;
+    }
+}
+
+} // namespace
+
+const char* gemm_batched_kernel_name() {
+    switch (active_isa()) {
+        case BatchIsa::Avx512: return "avx512";
+        case BatchIsa::Avx2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+void gemm_batched(const GemmTriple* items, int count, int m, int k, int n) {
+    check_dims(count, m, k, n);
+    if (count == 0) {
+        return;
+    }
+    check_null(items, "items");
+    for (int b = 0; b < count; ++b) {
+        check_null(items[b].A, "matrixA");
+        check_null(items[b].B, "matrixB");
+        check_null(items[b].C, "result");
+    }
+    dispatch_batch(TripleBatch{items}, count, m, k, n);
+}
+
+void gemm_batched_strided(const double* A, std::ptrdiff_t strideA, const double* B, std::ptrdiff_t strideB,
+                          double* C, std::ptrdiff_t strideC, int count, int m, int k, int n) {
+    check_dims(count, m, k, n);
+    if (count == 0) {
+        return;
+    }
+    check_null(A, "matrixA");
+    check_null(B, "matrixB");
+    check_null(C, "result");
+    dispatch_batch(StridedBatch{A, strideA, B, strideB, C, strideC}, count, m, k, n);
+}
+
+std::size_t interleaved_size(int count, int rows, int cols) {
+    std::size_t groups = (static_cast<std::size_t>(std::max(count, 0)) + W - 1) / W;
+    return groups * W * static_cast<std::size_t>(rows) * cols;
+}
+
+void interleave_batch(const double* src, std::ptrdiff_t stride, int count, int rows, int cols, double* dst) {
+    check_null(src, "src");
+    check_null(dst, "dst");
+    const int elems = rows * cols;
+    std::fill(dst, dst + interleaved_size(count, rows, cols), 0.0);
+    for (int b = 0; b < count; ++b) {
+        const double* m = src + b * stride;
+        double* group = dst + static_cast<std::ptrdiff_t>(b / W) * elems * W;
+        for (int e = 0; e < elems; ++e) {
+            group[e * W + b % W] = m[e];
+        }
+    }
+}
+
+void deinterleave_batch(const double* src, int count, int rows, int cols, double* dst, std::ptrdiff_t stride) {
+    check_null(src, "src");
+    check_null(dst, "dst");
+    const int elems = rows * cols;
+    for (int b = 0; b < count; ++b) {
+        double* m = dst + b * stride;
+        const double* group = src + static_cast<std::ptrdiff_t>(b / W) * elems * W;
+        for (int e = 0; e < elems; ++e) {
+            m[e] = group[e * W + b % W];
+        }
+    }
+}
+
+void gemm_batched_interleaved(const double* A, const double* B, double* C, int count, int m, int k, int n) {
+    check_dims(count, m, k, n);
+    if (count == 0) {
+        return;
+    }
+    check_null(A, "matrixA");
+    check_null(B, "matrixB");
+    check_null(C, "result");
+    const int groups = (count + W - 1) / W;
+    switch (active_isa()) {
+#ifdef BATCH_HAVE_X86
+        case BatchIsa::Avx512: interleaved_avx512(A, B, C, groups, m, k, n); return;
+        case BatchIsa::Avx2: interleaved_avx2(A, B, C, groups, m, k, n); return;
+#endif
+        default: interleaved_scalar(A, B, C, groups, m, k, n); return;
+    }
+}
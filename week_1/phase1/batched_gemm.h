@@ -0,0 +1,47 @@
+#ifndef BATCHED_GEMM_H
+#define BATCHED_GEMM_H
+
+// Many small independent products C_b = A_b * B_b in one call (dense
+// row-major, every product the same m x k x n). Dimension checks and CPU
+// dispatch happen once per batch instead of once per product, and square
+// 8/16/24/32 products run kernels whose loop bounds are template parameters,
+// so they are fully unrolled with C kept in registers. Other shapes use a
+// runtime-bounds kernel.
+
+#include <cstddef>
+
+struct GemmTriple {
+    const double* A;
+    const double* B;
+    double* C;
+};
+
+// Name of the instruction set the batched kernels were dispatched to
+const char* gemm_batched_kernel_name();
+
+void gemm_batched(const GemmTriple* items, int count, int m, int k, int n);
+
+// Product b reads A + b * strideA and B + b * strideB and writes C + b * strideC
+// (strides in elements)
+void gemm_batched_strided(const double* A, std::ptrdiff_t strideA, const double* B, std::ptrdiff_t strideB,
+                          double* C, std::ptrdiff_t strideC, int count, int m, int k, int n);
+
+// Interleaved layout: matrices are stored in groups of kBatchLanes, and element
+// (i, j) of matrix l in a group sits at group + (i * cols + j) * kBatchLanes + l.
+// One SIMD register then holds the same element of kBatchLanes matrices, so
+// the kernel vectorises across the batch whatever the matrix shape -- the
+// layout to use when n is too small to fill a vector on its own. The last
+// group is zero padded.
+constexpr int kBatchLanes = 8;
+
+// Doubles needed for `count` interleaved rows x cols matrices
+std::size_t interleaved_size(int count, int rows, int cols);
+
+void interleave_batch(const double* src, std::ptrdiff_t stride, int count, int rows, int cols, double* dst);
+
+void deinterleave_batch(const double* src, int count, int rows, int cols, double* dst, std::ptrdiff_t stride);
+
+// A, B and C are all in the interleaved layout
+void gemm_batched_interleaved(const double* A, const double* B, double* C, int count, int m, int k, int n);
+
+#endif
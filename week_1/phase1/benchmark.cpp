@@ -1,47 +1,180 @@
 #include "benchmark.h"
 #include <vector>
-#include <numeric> 
-#include <cmath>  
+#include <numeric>
+#include <cmath>
 #include <iostream>
-#include <iomanip> 
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#ifdef __linux__
+#include <sched.h>
+#endif
 using std::pair;
 using std::vector;
 using std::function;
-using std::chrono::high_resolution_clock;
-using std::chrono::duration;
-using std::milli;
 using std::accumulate;
-using std::inner_product;
 using std::sqrt;
 
-pair<double, double> time_function_ms(function<void()> func, int runs) {
-    if (runs <= 0) {
-        return {0.0, 0.0};
+namespace {
+
+// Two-sided 95% Student t quantiles for 1..30 degrees of freedom; 1.96 beyond
+double t_quantile_95(int dof) {
+    static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                   2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (dof < 1) {
+        return 0.0;
+    }
+    return dof <= 30 ? table[dof - 1] : 1.96;
+}
+
+pair<double, double> mean_and_std_dev(const vector<double>& samples) {
+    double mean = accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    double sq_sum = 0.0;
+    for (double s : samples) {
+        sq_sum += (s - mean) * (s - mean);
+    }
+    double std_dev = samples.size() > 1 ? sqrt(sq_sum / (samples.size() - 1)) : 0.0;
+    return {mean, std_dev};
+}
+
+// Linear interpolation between closest ranks; `sorted` must be non-empty
+double percentile(const vector<double>& sorted, double p) {
+    double rank = p * (sorted.size() - 1);
+    size_t lo = static_cast<size_t>(rank);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (rank - lo) * (sorted[hi] - sorted[lo]);
+}
+
+double ci95_half_width(double std_dev, size_t n) {
+    return n > 1 ? t_quantile_95(static_cast<int>(n) - 1) * std_dev / sqrt(static_cast<double>(n)) : 0.0;
+}
+
+std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
     }
+    return out;
+}
 
-    vector<double> timings_ms;
-    timings_ms.reserve(runs);
+} // namespace
 
-    for (int i = 0; i < runs; ++i) {
-        auto start = high_resolution_clock::now();
-        func();
-        auto end = high_resolution_clock::now();
-        duration<double, milli> duration_ms = end - start;
-        timings_ms.push_back(duration_ms.count());
+ScopedCpuPin::ScopedCpuPin(int cpu) {
+#ifdef __linux__
+    if (cpu < 0) {
+        return;
+    }
+    cpu_set_t old_set;
+    if (sched_getaffinity(0, sizeof(old_set), &old_set) != 0) {
+        return;
     }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) == 0) {
+        saved_mask_.resize(sizeof(old_set));
+        std::memcpy(saved_mask_.data(), &old_set, sizeof(old_set));
+        pinned_ = true;
+    }
+#else
+    (void)cpu;
+#endif
+}
 
-    if (timings_ms.empty()) {
-        return {0.0, 0.0};
+ScopedCpuPin::~ScopedCpuPin() {
+#ifdef __linux__
+    if (pinned_) {
+        cpu_set_t old_set;
+        std::memcpy(&old_set, saved_mask_.data(), sizeof(old_set));
+        sched_setaffinity(0, sizeof(old_set), &old_set);
     }
+#endif
+}
 
-    double sum = accumulate(timings_ms.begin(), timings_ms.end(), 0.0);
-    double avg = sum / timings_ms.size();
+BenchmarkStats summarize_samples(vector<double>& samples_ms, int iterations) {
+    BenchmarkStats stats;
+    stats.iterations = iterations;
+    stats.runs = static_cast<int>(samples_ms.size());
+    if (samples_ms.empty()) {
+        return stats;
+    }
 
-    double sq_sum = inner_product(timings_ms.begin(), timings_ms.end(), timings_ms.begin(), 0.0);
-    double std_dev = 0.0;
-    if (timings_ms.size() > 1) {
-         std_dev = sqrt((sq_sum / timings_ms.size()) - (avg * avg));
+    auto [mean, std_dev] = mean_and_std_dev(samples_ms);
+    stats.mean_ms = mean;
+    stats.std_dev_ms = std_dev;
+    stats.ci95_ms = ci95_half_width(std_dev, samples_ms.size());
+
+    std::sort(samples_ms.begin(), samples_ms.end());
+    stats.min_ms = samples_ms.front();
+    stats.max_ms = samples_ms.back();
+    stats.median_ms = percentile(samples_ms, 0.5);
+    stats.p90_ms = percentile(samples_ms, 0.9);
+    stats.p99_ms = percentile(samples_ms, 0.99);
+
+    vector<double> deviations(samples_ms.size());
+    std::transform(samples_ms.begin(), samples_ms.end(), deviations.begin(),
+                   [&](double s) { return std::abs(s - stats.median_ms); });
+    std::sort(deviations.begin(), deviations.end());
+    stats.mad_ms = percentile(deviations, 0.5);
+    return stats;
+}
+
+bool benchmark_converged(const vector<double>& samples_ms, double target_rel_ci) {
+    if (samples_ms.size() < 2) {
+        return false;
+    }
+    auto [mean, std_dev] = mean_and_std_dev(samples_ms);
+    return mean > 0.0 && ci95_half_width(std_dev, samples_ms.size()) <= target_rel_ci * mean;
+}
+
+BenchmarkResult make_result(const std::string& name, int rowsA, int colsA, int colsB, const BenchmarkStats& stats) {
+    BenchmarkResult result{name, rowsA, colsA, colsB, stats.mean_ms, stats.std_dev_ms, stats.runs};
+    result.median_ms = stats.median_ms;
+    result.p90_ms = stats.p90_ms;
+    result.p99_ms = stats.p99_ms;
+    result.mad_ms = stats.mad_ms;
+    result.ci95_ms = stats.ci95_ms;
+    return result;
+}
+
+void write_results_csv(std::ostream& out, const vector<BenchmarkResult>& results) {
+    out << "name,rowsA,colsA,colsB,runs,avg_ms,std_dev_ms,median_ms,p90_ms,p99_ms,mad_ms,ci95_ms\n";
+    out << std::setprecision(9);
+    for (const auto& r : results) {
+        out << '"' << r.name << "\"," << r.rowsA << ',' << r.colsA << ',' << r.colsB << ',' << r.runs << ','
+            << r.avg_time_ms << ',' << r.std_dev_ms << ',' << r.median_ms << ',' << r.p90_ms << ','
+            << r.p99_ms << ',' << r.mad_ms << ',' << r.ci95_ms << '\n';
+    }
+}
+
+void write_results_json(std::ostream& out, const vector<BenchmarkResult>& results) {
+    out << std::setprecision(9) << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        out << "  {\"name\": \"" << json_escape(r.name) << "\", \"rowsA\": " << r.rowsA
+            << ", \"colsA\": " << r.colsA << ", \"colsB\": " << r.colsB << ", \"runs\": " << r.runs
+            << ", \"avg_ms\": " << r.avg_time_ms << ", \"std_dev_ms\": " << r.std_dev_ms
+            << ", \"median_ms\": " << r.median_ms << ", \"p90_ms\": " << r.p90_ms
+            << ", \"p99_ms\": " << r.p99_ms << ", \"mad_ms\": " << r.mad_ms
+            << ", \"ci95_ms\": " << r.ci95_ms << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+pair<double, double> time_function_ms(function<void()> func, int runs) {
+    if (runs <= 0) {
+        return {0.0, 0.0};
     }
 
-    return {avg, std_dev};
-}
\ No newline at end of file
+    BenchmarkOptions options;
+    options.warmup_runs = 1;
+    options.min_runs = runs;
+    options.max_runs = runs;
+    options.min_sample_ms = 0.0;
+    BenchmarkStats stats = run_benchmark(func, options);
+    return {stats.mean_ms, stats.std_dev_ms};
+}
@@ -2,18 +2,146 @@
 #define BENCHMARK_H
 
 #include <chrono>
-#include <functional> 
+#include <functional>
+#include <iosfwd>
 #include <vector>
 #include <string>
 
+// Shared benchmark harness. Besides phase1 it is used by week_1/hw1 (build with
+// -I../phase1 and compile benchmark.cpp alongside); keep it free of matrix_ops
+// dependencies so other exercises can do the same.
+
 struct BenchmarkResult {
     std::string name;
     int rowsA, colsA, colsB;
     double avg_time_ms;
     double std_dev_ms;
     int runs;
+    // Filled in from BenchmarkStats by make_result; zero for hand-built rows
+    double median_ms = 0.0;
+    double p90_ms = 0.0;
+    double p99_ms = 0.0;
+    double mad_ms = 0.0;
+    double ci95_ms = 0.0;
+};
+
+// Adaptive measurement: after warmup, samples are taken until the 95% confidence
+// interval of the mean is within target_rel_ci of it, or a run/time cap is hit.
+// Each sample repeats the function enough times to last min_sample_ms, so
+// microsecond kernels are not measured at clock resolution.
+struct BenchmarkOptions {
+    int warmup_runs = 2;
+    int min_runs = 5;
+    int max_runs = 200;
+    double max_time_ms = 1000.0;  // wall-clock budget for the sampling phase
+    double target_rel_ci = 0.02;  // CI half-width / mean
+    double min_sample_ms = 0.05;
+    int pin_cpu = -1;             // >= 0: pin the calling thread to this CPU while measuring
+};
+
+// Per-call times in milliseconds
+struct BenchmarkStats {
+    int runs = 0;          // samples taken
+    int iterations = 1;    // calls per sample
+    double mean_ms = 0.0;
+    double std_dev_ms = 0.0;
+    double min_ms = 0.0;
+    double median_ms = 0.0;
+    double p90_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+    double mad_ms = 0.0;   // median absolute deviation
+    double ci95_ms = 0.0;  // half-width of the 95% CI of the mean
+    bool converged = false;
+};
+
+// Compiler barriers: keep a value (and everything it points at) alive, and
+// force pending stores to memory, without emitting any instructions
+template <typename T>
+inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+// Pins the calling thread for the lifetime of the object and restores the
+// previous affinity afterwards. No-op for cpu < 0 or off Linux.
+class ScopedCpuPin {
+public:
+    explicit ScopedCpuPin(int cpu);
+    ~ScopedCpuPin();
+    ScopedCpuPin(const ScopedCpuPin&) = delete;
+    ScopedCpuPin& operator=(const ScopedCpuPin&) = delete;
+    bool pinned() const { return pinned_; }
+
+private:
+    bool pinned_ = false;
+    std::vector<unsigned char> saved_mask_;
 };
 
+// Reduces per-call sample times to summary statistics (sorts the vector)
+BenchmarkStats summarize_samples(std::vector<double>& samples_ms, int iterations);
+
+// Relative CI of the samples so far; run_benchmark stops once it is small enough
+bool benchmark_converged(const std::vector<double>& samples_ms, double target_rel_ci);
+
+// Times func directly (no std::function in the timed region)
+template <typename F>
+BenchmarkStats run_benchmark(F&& func, const BenchmarkOptions& options = BenchmarkOptions()) {
+    using clock = std::chrono::steady_clock;
+    ScopedCpuPin pin(options.pin_cpu);
+
+    // Warmup doubles as calibration of the per-sample repeat count
+    int iterations = 1;
+    for (int w = 0; w < options.warmup_runs || w == 0; ++w) {
+        auto start = clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            func();
+            clobber_memory();
+        }
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        while (ms * 2 < options.min_sample_ms && iterations < (1 << 20)) {
+            iterations *= 2;
+            ms *= 2;
+        }
+    }
+
+    std::vector<double> samples_ms;
+    samples_ms.reserve(options.max_runs);
+    auto budget_start = clock::now();
+    bool converged = false;
+    while (static_cast<int>(samples_ms.size()) < options.max_runs) {
+        auto start = clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            func();
+            clobber_memory();
+        }
+        auto end = clock::now();
+        samples_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count() / iterations);
+
+        if (static_cast<int>(samples_ms.size()) < options.min_runs) {
+            continue;
+        }
+        converged = benchmark_converged(samples_ms, options.target_rel_ci);
+        if (converged || std::chrono::duration<double, std::milli>(end - budget_start).count() > options.max_time_ms) {
+            break;
+        }
+    }
+
+    BenchmarkStats stats = summarize_samples(samples_ms, iterations);
+    stats.converged = converged;
+    return stats;
+}
+
+BenchmarkResult make_result(const std::string& name, int rowsA, int colsA, int colsB, const BenchmarkStats& stats);
+
+void write_results_csv(std::ostream& out, const std::vector<BenchmarkResult>& results);
+void write_results_json(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+// Fixed-count timing kept for existing callers: one warmup call, then exactly
+// `runs` timed calls. Returns {mean, std dev} in ms.
 std::pair<double, double> time_function_ms(std::function<void()> func, int runs);
 
-#endif 
\ No newline at end of file
+#endif
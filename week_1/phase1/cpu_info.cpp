@@ -0,0 +1,55 @@
+#include "cpu_info.h"
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+std::string read_model_name() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        // x86 reports "model name", most arm64 kernels only give "CPU part"
+        if (line.rfind("model name", 0) == 0 || line.rfind("CPU part", 0) == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                size_t start = line.find_first_not_of(' ', colon + 1);
+                return start == std::string::npos ? "" : line.substr(start);
+            }
+        }
+    }
+    return "unknown";
+}
+
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+std::size_t cache_size_or(int name, std::size_t fallback) {
+    long size = sysconf(name);
+    return size > 0 ? static_cast<std::size_t>(size) : fallback;
+}
+#endif
+
+CpuInfo detect() {
+    CpuInfo info;
+    info.model = read_model_name();
+
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    info.has_avx2 = __builtin_cpu_supports("avx2");
+    info.has_fma = __builtin_cpu_supports("fma");
+    info.has_avx512f = __builtin_cpu_supports("avx512f");
+#endif
+
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    info.l1d_bytes = cache_size_or(_SC_LEVEL1_DCACHE_SIZE, info.l1d_bytes);
+    info.l2_bytes = cache_size_or(_SC_LEVEL2_CACHE_SIZE, info.l2_bytes);
+    info.l3_bytes = cache_size_or(_SC_LEVEL3_CACHE_SIZE, info.l3_bytes);
+#endif
+    return info;
+}
+
+} // namespace
+
+const CpuInfo& cpu_info() {
+    static const CpuInfo info = detect();
+    return info;
+}
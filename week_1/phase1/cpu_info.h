@@ -0,0 +1,20 @@
+#ifndef CPU_INFO_H
+#define CPU_INFO_H
+
+#include <cstddef>
+#include <string>
+
+struct CpuInfo {
+    std::string model;        // brand string, e.g. "Intel(R) Xeon(R) ..."
+    bool has_avx2 = false;
+    bool has_fma = false;
+    bool has_avx512f = false;
+    std::size_t l1d_bytes = 32 * 1024;       // defaults used when the OS won't tell us
+    std::size_t l2_bytes = 256 * 1024;
+    std::size_t l3_bytes = 8 * 1024 * 1024;
+};
+
+// Detected once on first call, then cached for the lifetime of the process
+const CpuInfo& cpu_info();
+
+#endif
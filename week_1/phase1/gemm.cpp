@@ -0,0 +1,346 @@
+#include "gemm.h"
+#include "alignment.h"
+#include "cpu_info.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GEMM_HAVE_X86 1
+#endif
+
+namespace {
+
+// P is the packed / accumulation type: the micro-kernel only ever sees P
+template <typename P>
+using MicroKernel = void (*)(int kc, const P* Ap, const P* Bp, P* C, int ldc);
+
+template <typename P>
+struct KernelInfo {
+    const char* name;
+    int mr;
+    int nr;
+    MicroKernel<P> kernel;
+};
+
+// Portable fallback: C[4x4] += Ap * Bp. Small enough that -O3 keeps acc in registers.
+template <typename P>
+void kernel_4x4_scalar(int kc, const P* Ap, const P* Bp, P* C, int ldc) {
+    P acc[4][4] = {};
+    for (int p = 0; p < kc; ++p) {
+        for (int i = 0; i < 4; ++i) {
+            const P a = Ap[i];
+            for (int j = 0; j < 4; ++j) {
+                acc[i][j] += a * Bp[j];
+            }
+        }
+        Ap += 4;
+        Bp += 4;
+    }
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            C[i * ldc + j] += acc[i][j];
+        }
+    }
+}
+
+#ifdef GEMM_HAVE_X86
+// 6 rows x 8 cols: 12 ymm accumulators + 2 for B + 1 broadcast of A
+__attribute__((target("avx2,fma")))
+void kernel_6x8_avx2(int kc, const double* Ap, const double* Bp, double* C, int ldc) {
+    __m256d c[6][2];
+    for (int i = 0; i < 6; ++i) {
+        c[i][0] = _mm256_loadu_pd(C + i * ldc);
+        c[i][1] = _mm256_loadu_pd(C + i * ldc + 4);
+    }
+    for (int p = 0; p < kc; ++p) {
+        const __m256d b0 = _mm256_load_pd(Bp);
+        const __m256d b1 = _mm256_load_pd(Bp + 4);
+        for (int i = 0; i < 6; ++i) {
+            const __m256d a = _mm256_broadcast_sd(Ap + i);
+            c[i][0] = _mm256_fmadd_pd(a, b0, c[i][0]);
+            c[i][1] = _mm256_fmadd_pd(a, b1, c[i][1]);
+        }
+        Ap += 6;
+        Bp += 8;
+    }
+    for (int i = 0; i < 6; ++i) {
+        _mm256_storeu_pd(C + i * ldc, c[i][0]);
+        _mm256_storeu_pd(C + i * ldc + 4, c[i][1]);
+    }
+}
+
+// 6 rows x 16 cols: 12 zmm accumulators, same shape as the AVX2 kernel at twice the width
+__attribute__((target("avx512f")))
+void kernel_6x16_avx512(int kc, const double* Ap, const double* Bp, double* C, int ldc) {
+    __m512d c[6][2];
+    for (int i = 0; i < 6; ++i) {
+        c[i][0] = _mm512_loadu_pd(C + i * ldc);
+        c[i][1] = _mm512_loadu_pd(C + i * ldc + 8);
+    }
+    for (int p = 0; p < kc; ++p) {
+        const __m512d b0 = _mm512_load_pd(Bp);
+        const __m512d b1 = _mm512_load_pd(Bp + 8);
+        for (int i = 0; i < 6; ++i) {
+            const __m512d a = _mm512_set1_pd(Ap[i]);
+            c[i][0] = _mm512_fmadd_pd(a, b0, c[i][0]);
+            c[i][1] = _mm512_fmadd_pd(a, b1, c[i][1]);
+        }
+        Ap += 6;
+        Bp += 16;
+    }
+    for (int i = 0; i < 6; ++i) {
+        _mm512_storeu_pd(C + i * ldc, c[i][0]);
+        _mm512_storeu_pd(C + i * ldc + 8, c[i][1]);
+    }
+}
+
+// Single-precision twins: same register budget, twice the columns per tile
+__attribute__((target("avx2,fma")))
+void kernel_6x16_avx2_f32(int kc, const float* Ap, const float* Bp, float* C, int ldc) {
+    __m256 c[6][2];
+    for (int i = 0; i < 6; ++i) {
+        c[i][0] = _mm256_loadu_ps(C + i * ldc);
+        c[i][1] = _mm256_loadu_ps(C + i * ldc + 8);
+    }
+    for (int p = 0; p < kc; ++p) {
+        const __m256 b0 = _mm256_load_ps(Bp);
+        const __m256 b1 = _mm256_load_ps(Bp + 8);
+        for (int i = 0; i < 6; ++i) {
+            const __m256 a = _mm256_broadcast_ss(Ap + i);
+            c[i][0] = _mm256_fmadd_ps(a, b0, c[i][0]);
+            c[i][1] = _mm256_fmadd_ps(a, b1, c[i][1]);
+        }
+        Ap += 6;
+        Bp += 16;
+    }
+    for (int i = 0; i < 6; ++i) {
+        _mm256_storeu_ps(C + i * ldc, c[i][0]);
+        _mm256_storeu_ps(C + i * ldc + 8, c[i][1]);
+    }
+}
+
+__attribute__((target("avx512f")))
+void kernel_6x32_avx512_f32(int kc, const float* Ap, const float* Bp, float* C, int ldc) {
+    __m512 c[6][2];
+    for (int i = 0; i < 6; ++i) {
+        c[i][0] = _mm512_loadu_ps(C + i * ldc);
+        c[i][1] = _mm512_loadu_ps(C + i * ldc + 16);
+    }
+    for (int p = 0; p < kc; ++p) {
+        const __m512 b0 = _mm512_load_ps(Bp);
+        const __m512 b1 = _mm512_load_ps(Bp + 16);
+        for (int i = 0; i < 6; ++i) {
+            const __m512 a = _mm512_set1_ps(Ap[i]);
+            c[i][0] = _mm512_fmadd_ps(a, b0, c[i][0]);
+            c[i][1] = _mm512_fmadd_ps(a, b1, c[i][1]);
+        }
+        Ap += 6;
+        Bp += 32;
+    }
+    for (int i = 0; i < 6; ++i) {
+        _mm512_storeu_ps(C + i * ldc, c[i][0]);
+        _mm512_storeu_ps(C + i * ldc + 16, c[i][1]);
+    }
+}
+#endif
+
+template <typename P>
+KernelInfo<P> select_kernel() {
+#ifdef GEMM_HAVE_X86
+    const CpuInfo& cpu = cpu_info();
+    if constexpr (std::is_same_v<P, double>) {
+        if (cpu.has_avx512f) {
+            return {"avx512", 6, 16, kernel_6x16_avx512};
+        }
+        if (cpu.has_avx2 && cpu.has_fma) {
+            return {"avx2", 6, 8, kernel_6x8_avx2};
+        }
+    } else {
+        if (cpu.has_avx512f) {
+            return {"avx512", 6, 32, kernel_6x32_avx512_f32};
+        }
+        if (cpu.has_avx2 && cpu.has_fma) {
+            return {"avx2", 6, 16, kernel_6x16_avx2_f32};
+        }
+    }
+#endif
+    return {"scalar", 4, 4, kernel_4x4_scalar<P>};
+}
+
+template <typename P>
+const KernelInfo<P>& active_kernel() {
+    static const KernelInfo<P> kernel = select_kernel<P>();
+    return kernel;
+}
+
+int round_down(int value, int multiple) {
+    return std::max(multiple, value / multiple * multiple);
+}
+
+GemmBlocking blocking_for(int mr, int nr, int bytes) {
+    const CpuInfo& cpu = cpu_info();
+
+    // B micro-panel (kc x NR) should take about half of L1, leaving room for A and C
+    int kc = static_cast<int>(cpu.l1d_bytes / 2) / (nr * bytes);
+    kc = std::clamp(round_down(kc, 8), 64, 512);
+
+    // Packed A block (mc x kc) should take about half of L2
+    int mc = static_cast<int>(cpu.l2_bytes / 2) / (kc * bytes);
+    mc = std::clamp(round_down(mc, mr), mr, 1024 / mr * mr);
+
+    // Packed B block (kc x nc) gets half of L3, which is shared with the other cores
+    int nc = static_cast<int>(std::min<std::size_t>(cpu.l3_bytes / 2, 64u << 20) / (kc * bytes));
+    nc = std::clamp(round_down(nc, nr), nr, 8192 / nr * nr);
+
+    return {mc, kc, nc};
+}
+
+// Copy an mc x kc block of A into MR-row panels, column by column, zero-padding the last panel.
+// Converting T -> P here is what gives the mixed-precision path double accumulation for free.
+template <typename T, typename P>
+void pack_A(int mc, int kc, const T* A, int lda, P* Ap, int mr) {
+    for (int ir = 0; ir < mc; ir += mr) {
+        const int rows = std::min(mr, mc - ir);
+        for (int p = 0; p < kc; ++p) {
+            for (int i = 0; i < rows; ++i) {
+                Ap[i] = static_cast<P>(A[(ir + i) * lda + p]);
+            }
+            for (int i = rows; i < mr; ++i) {
+                Ap[i] = P(0);
+            }
+            Ap += mr;
+        }
+    }
+}
+
+// Copy a kc x nc block of B into NR-column panels, row by row, zero-padding the last panel
+template <typename T, typename P>
+void pack_B(int kc, int nc, const T* B, int ldb, P* Bp, int nr) {
+    for (int jr = 0; jr < nc; jr += nr) {
+        const int cols = std::min(nr, nc - jr);
+        for (int p = 0; p < kc; ++p) {
+            const T* row = B + p * ldb + jr;
+            for (int j = 0; j < cols; ++j) {
+                Bp[j] = static_cast<P>(row[j]);
+            }
+            for (int j = cols; j < nr; ++j) {
+                Bp[j] = P(0);
+            }
+            Bp += nr;
+        }
+    }
+}
+
+template <typename T, typename P>
+void packed_driver(MatrixView<const T> matrixA, MatrixView<const T> matrixB, MatrixView<T> result) {
+    if (!matrixA.data() || !matrixB.data() || !result.data()) {
+        throw std::invalid_argument("Matrix pointers cannot be null.");
+    }
+    if (matrixA.cols() != matrixB.rows() || result.rows() != matrixA.rows() || result.cols() != matrixB.cols()) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
+    }
+
+    const int rowsA = matrixA.rows();
+    const int colsA = matrixA.cols();
+    const int colsB = matrixB.cols();
+    const int lda = matrixA.ld();
+    const int ldb = matrixB.ld();
+    const int ldc = result.ld();
+    for (int i = 0; i < rowsA; ++i) {
+        std::fill_n(result.line(i), colsB, T(0));
+    }
+
+    const KernelInfo<P>& k = active_kernel<P>();
+    static const GemmBlocking blk = blocking_for(k.mr, k.nr, static_cast<int>(sizeof(P)));
+    const int MR = k.mr;
+    const int NR = k.nr;
+    // When C is stored narrower than P, tiles are computed in P and rounded once per kc panel
+    constexpr bool direct = std::is_same_v<T, P>;
+
+    // Packing buffers are reused across calls so the hot path never allocates
+    thread_local std::vector<P, AlignedAllocator<P, 64>> packedA;
+    thread_local std::vector<P, AlignedAllocator<P, 64>> packedB;
+    const size_t a_size = static_cast<size_t>((blk.mc + MR - 1) / MR * MR) * blk.kc;
+    const size_t b_size = static_cast<size_t>((blk.nc + NR - 1) / NR * NR) * blk.kc;
+    if (packedA.size() < a_size) packedA.resize(a_size);
+    if (packedB.size() < b_size) packedB.resize(b_size);
+
+    alignas(64) P edge[6 * 32];
+
+    for (int jc = 0; jc < colsB; jc += blk.nc) {
+        const int nc = std::min(blk.nc, colsB - jc);
+        for (int pc = 0; pc < colsA; pc += blk.kc) {
+            const int kc = std::min(blk.kc, colsA - pc);
+            pack_B(kc, nc, &matrixB(pc, jc), ldb, packedB.data(), NR);
+
+            for (int ic = 0; ic < rowsA; ic += blk.mc) {
+                const int mc = std::min(blk.mc, rowsA - ic);
+                pack_A(mc, kc, &matrixA(ic, pc), lda, packedA.data(), MR);
+
+                for (int jr = 0; jr < nc; jr += NR) {
+                    const int nr = std::min(NR, nc - jr);
+                    const P* Bp = packedB.data() + jr * kc;
+                    for (int ir = 0; ir < mc; ir += MR) {
+                        const int mr = std::min(MR, mc - ir);
+                        const P* Ap = packedA.data() + ir * kc;
+                        T* C = &result(ic + ir, jc + jr);
+
+                        if constexpr (direct) {
+                            if (mr == MR && nr == NR) {
+                                k.kernel(kc, Ap, Bp, C, ldc);
+                                continue;
+                            }
+                        }
+                        // Partial (or mixed-precision) tile: run the full kernel on a scratch tile, keep the valid part
+                        std::fill_n(edge, MR * NR, P(0));
+                        k.kernel(kc, Ap, Bp, edge, NR);
+                        for (int i = 0; i < mr; ++i) {
+                            for (int j = 0; j < nr; ++j) {
+                                C[i * ldc + j] = static_cast<T>(C[i * ldc + j] + edge[i * NR + j]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+const char* gemm_kernel_name() {
+    return active_kernel<double>().name;
+}
+
+GemmBlocking gemm_default_blocking() {
+    const KernelInfo<double>& k = active_kernel<double>();
+    return blocking_for(k.mr, k.nr, static_cast<int>(sizeof(double)));
+}
+
+void multiply_mm_packed(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result) {
+    if (!matrixA || !matrixB || !result) {
+        throw std::invalid_argument("Matrix pointers cannot be null.");
+    }
+    if (colsA != rowsB) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
+    }
+    multiply_mm_packed(MatrixView<const double>(matrixA, rowsA, colsA), MatrixView<const double>(matrixB, rowsB, colsB),
+                       MatrixView<double>(result, rowsA, colsB));
+}
+
+void multiply_mm_packed(MatrixView<const double> matrixA, MatrixView<const double> matrixB, MatrixView<double> result) {
+    packed_driver<double, double>(matrixA, matrixB, result);
+}
+
+template <typename T, typename Acc>
+void gemm_packed(MatrixView<const T> matrixA, MatrixView<const T> matrixB, MatrixView<T> result) {
+    packed_driver<T, Acc>(matrixA, matrixB, result);
+}
+
+template void gemm_packed<double, double>(MatrixView<const double>, MatrixView<const double>, MatrixView<double>);
+template void gemm_packed<float, float>(MatrixView<const float>, MatrixView<const float>, MatrixView<float>);
+template void gemm_packed<float, double>(MatrixView<const float>, MatrixView<const float>, MatrixView<float>);
@@ -0,0 +1,36 @@
+#ifndef GEMM_H
+#define GEMM_H
+
+// Packed, register-blocked GEMM (C = A * B, all row-major).
+// A and B are copied into contiguous MR-row / NR-column panels sized to the
+// cache hierarchy, and an MR x NR tile of C is kept in SIMD registers while
+// the k loop runs. The micro-kernel is picked once at runtime:
+// AVX-512 (6x16) -> AVX2+FMA (6x8) -> portable scalar (4x4).
+
+#include "matrix.h"
+
+struct GemmBlocking {
+    int mc; // rows of A packed per L2 block
+    int kc; // depth of one packed panel (B micro-panel stays in L1)
+    int nc; // columns of B packed per L3 block
+};
+
+// Name of the micro-kernel selected for this CPU ("avx512", "avx2", "scalar")
+const char* gemm_kernel_name();
+
+// Blocking derived from the detected L1/L2/L3 sizes for the selected kernel
+GemmBlocking gemm_default_blocking();
+
+void multiply_mm_packed(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result);
+
+// Strided overload: any of the operands may be a sub-block of a larger matrix
+void multiply_mm_packed(MatrixView<const double> matrixA, MatrixView<const double> matrixB, MatrixView<double> result);
+
+// Precision-generic version. T is the storage type and Acc the type the panels
+// are packed and accumulated in: <double>, <float> (twice the SIMD lanes, half
+// the bandwidth) or <float, double> (float in memory, double in registers,
+// rounded back to float once per kc panel). Instantiated for those three.
+template <typename T, typename Acc = T>
+void gemm_packed(MatrixView<const T> matrixA, MatrixView<const T> matrixB, MatrixView<T> result);
+
+#endif
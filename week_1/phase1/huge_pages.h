@@ -0,0 +1,125 @@
+#ifndef HUGE_PAGES_H
+#define HUGE_PAGES_H
+
+// Page-level allocation for large, long-lived buffers (matrices, pools).
+// Regions of at least half a huge page are rounded up to 2MB and placed on a
+// 2MB boundary so the kernel can back them with huge pages; smaller ones get
+// ordinary 4KB pages. Every mapping comes straight from mmap, so this is not
+// meant for small or short-lived allocations.
+//
+//   Transparent: madvise(MADV_HUGEPAGE) on an aligned anonymous mapping
+//   Explicit:    MAP_HUGETLB from the reserved pool (vm.nr_hugepages),
+//                falling back to Transparent when none are reserved
+//
+// prefault touches every page up front so page faults are not taken on the
+// hot path; lock additionally mlock()s the region (best effort: silently
+// skipped when RLIMIT_MEMLOCK is too low).
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <sys/mman.h>
+
+enum class HugePageMode { None, Transparent, Explicit };
+
+struct HugePageOptions {
+    HugePageMode mode = HugePageMode::Transparent;
+    bool prefault = false;
+    bool lock = false;
+};
+
+constexpr std::size_t kSmallPageSize = 4096;
+constexpr std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+// Length actually mapped for a request of `bytes`; only depends on `bytes`, so
+// the deallocation path can recompute it
+inline std::size_t huge_page_region_size(std::size_t bytes) {
+    std::size_t page = bytes >= kHugePageSize / 2 ? kHugePageSize : kSmallPageSize;
+    return (bytes + page - 1) / page * page;
+}
+
+namespace huge_pages_detail {
+
+inline void* map_anonymous(std::size_t length, int extra_flags) {
+    void* ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+// Over-map by one huge page and trim both ends so the region starts on a 2MB boundary
+inline void* map_huge_aligned(std::size_t length) {
+    char* raw = static_cast<char*>(map_anonymous(length + kHugePageSize, 0));
+    if (!raw) {
+        return nullptr;
+    }
+    std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(raw);
+    char* aligned = reinterpret_cast<char*>((addr + kHugePageSize - 1) & ~(kHugePageSize - 1));
+    std::size_t head = static_cast<std::size_t>(aligned - raw);
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    std::size_t tail = kHugePageSize - head;
+    if (tail > 0) {
+        munmap(aligned + length, tail);
+    }
+    return aligned;
+}
+
+} // namespace huge_pages_detail
+
+inline void* huge_page_allocate(std::size_t bytes, const HugePageOptions& options = HugePageOptions()) {
+    std::size_t length = huge_page_region_size(bytes == 0 ? 1 : bytes);
+    bool huge = length % kHugePageSize == 0 && options.mode != HugePageMode::None;
+    void* ptr = nullptr;
+
+#ifdef MAP_HUGETLB
+    if (huge && options.mode == HugePageMode::Explicit) {
+        ptr = huge_pages_detail::map_anonymous(length, MAP_HUGETLB);
+    }
+#endif
+    if (!ptr && huge) {
+        ptr = huge_pages_detail::map_huge_aligned(length);
+#ifdef MADV_HUGEPAGE
+        if (ptr) {
+            madvise(ptr, length, MADV_HUGEPAGE);
+        }
+#endif
+    }
+    if (!ptr) {
+        ptr = huge_pages_detail::map_anonymous(length, 0);
+    }
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+
+    if (options.prefault) {
+        volatile char* bytes_ptr = static_cast<char*>(ptr);
+        for (std::size_t offset = 0; offset < length; offset += kSmallPageSize) {
+            bytes_ptr[offset] = 0;
+        }
+    }
+    if (options.lock) {
+        mlock(ptr, length);
+    }
+    return ptr;
+}
+
+inline void huge_page_deallocate(void* ptr, std::size_t bytes) noexcept {
+    if (ptr) {
+        munmap(ptr, huge_page_region_size(bytes == 0 ? 1 : bytes));
+    }
+}
+
+// Compile-time page policy for AlignedAllocator (see alignment.h). Mappings
+// are page aligned, which covers any Alignment up to 4KB.
+template <HugePageMode Mode = HugePageMode::Transparent, bool Prefault = false, bool Lock = false>
+struct HugePages {
+    static void* allocate(std::size_t bytes, std::size_t /*alignment*/) {
+        return huge_page_allocate(bytes, HugePageOptions{Mode, Prefault, Lock});
+    }
+
+    static void deallocate(void* ptr, std::size_t bytes) noexcept {
+        huge_page_deallocate(ptr, bytes);
+    }
+};
+
+#endif // HUGE_PAGES_H
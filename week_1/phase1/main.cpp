@@ -8,10 +8,26 @@
 #include <stdexcept>
 #include <functional>
 #include <string>
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <limits>
+#include <fstream>
+#include <sstream>
 
 #include "matrix_ops.h"
 #include "benchmark.h"
 #include "alignment.h"
+#include "gemm.h"
+#include "parallel_ops.h"
+#include "thread_pool.h"
+#include "autotune.h"
+#include "matrix.h"
+#include "perf_counters.h"
+#include "batched_gemm.h"
+#include "sparse.h"
 using std::cout;
 using std::cerr;
 using std::vector;
@@ -26,10 +42,10 @@ using std::left;
 using std::setw;
 using std::right;
 
-template <typename T>
-using AlignedVector = std::vector<T, AlignedAllocator<T, 64>>;
-
-vector<double> generate_random_vector(int size, bool aligned = false) {
+// Vec is std::vector<double> or AlignedVector<double>; values are written
+// straight into it so the aligned variant keeps its 64-byte alignment
+template <typename Vec = vector<double>>
+Vec generate_random_vector(int size) {
     if (size <= 0) {
         throw std::invalid_argument("Vector size must be positive.");
     }
@@ -38,31 +54,38 @@ vector<double> generate_random_vector(int size, bool aligned = false) {
     std::mt19937 gen(rd());
     std::uniform_real_distribution<> distrib(0.0, 1.0); 
 
-    if (aligned) {
-        AlignedVector<double> vec(size);
-        for (int i = 0; i < size; ++i) {
-            vec[i] = distrib(gen);
-        }
-        // Copy to std::vector to match function signature
-        return std::vector<double>(vec.begin(), vec.end());
-    } else {
-        std::vector<double> vec(size);
-        for (int i = 0; i < size; ++i) {
-            vec[i] = distrib(gen);
-        }
-        return vec;
+    Vec vec(size);
+    for (int i = 0; i < size; ++i) {
+        vec[i] = distrib(gen);
     }
+    return vec;
 }
 
-vector<double> generate_random_matrix(int rows, int cols, bool aligned = false) {
+template <typename Vec = vector<double>>
+Vec generate_random_matrix(int rows, int cols) {
     if (rows <= 0 || cols <= 0) {
         throw std::invalid_argument("Matrix dimensions must be positive.");
     }
-    return generate_random_vector(rows * cols, aligned);
+    return generate_random_vector<Vec>(rows * cols);
 }
 
+template <Layout L>
+Matrix<double, L> generate_random_matrix_aligned(int rows, int cols) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> distrib(0.0, 1.0);
+
+    Matrix<double, L> matrix(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            matrix(i, j) = distrib(gen);
+        }
+    }
+    return matrix;
+}
 
-vector<double> transpose_matrix(const vector<double>& matrix, int rows, int cols) {
+template <typename Vec>
+Vec transpose_matrix(const Vec& matrix, int rows, int cols) {
     if (rows <= 0 || cols <= 0) {
         throw std::invalid_argument("Matrix dimensions must be positive.");
     }
@@ -70,18 +93,25 @@ vector<double> transpose_matrix(const vector<double>& matrix, int rows, int cols
          throw std::invalid_argument("Matrix data size does not match dimensions.");
     }
 
-    vector<double> transposed(cols * rows); 
+    Vec transposed(cols * rows); 
+    transpose(matrix.data(), rows, cols, cols, transposed.data(), rows);
+    return transposed;
+}
+
+// Element-by-element reference: strided writes on every iteration
+void transpose_naive(const double* src, int rows, int cols, double* dst) {
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < cols; ++j) {
-            transposed[j * rows + i] = matrix[i * cols + j];
+            dst[j * rows + i] = src[i * cols + j];
         }
     }
-    return transposed;
 }
 
-bool check_result(const char* test_name, const double* calculated, const double* expected, size_t size, double tolerance = 1e-9) {
+// calculated may be float or double; the reference is always computed in double
+template <typename T>
+bool check_result(const char* test_name, const T* calculated, const double* expected, size_t size, double tolerance = 1e-9) {
     for (size_t i = 0; i < size; ++i) {
-        if (abs(calculated[i] - expected[i]) > tolerance) {
+        if (abs(static_cast<double>(calculated[i]) - expected[i]) > tolerance) {
             cerr << "Test Failed: " << test_name << "\n";
             cerr << "  Mismatch at index " << i << ": Calculated=" << calculated[i]
                       << ", Expected=" << expected[i] << endl;
@@ -92,6 +122,82 @@ bool check_result(const char* test_name, const double* calculated, const double*
     return true;
 }
 
+// Forward-error bound for length-k dot products accumulated in Acc and rounded to T
+// `roundings` times: |err| <= (k * eps(Acc) + roundings * eps(T)) * sum|a_i * b_i|.
+// With non-negative inputs sum|a_i * b_i| is the exact result, so magnitude = max |C|.
+template <typename T, typename Acc>
+double error_bound(int k, double magnitude, int roundings = 1) {
+    return (k * std::numeric_limits<Acc>::epsilon() + roundings * std::numeric_limits<T>::epsilon()) * magnitude;
+}
+
+// Per-call hardware counter readings for one benchmark row
+struct CounterRow {
+    string name;
+    int rowsA, colsA, colsB;
+    PerfSample sample;
+};
+
+struct BenchSession {
+    BenchmarkOptions options;
+    PerfCounters counters;
+    vector<CounterRow> counter_rows;
+};
+
+// Times one kernel with the adaptive harness and appends its table row; when
+// counters are available, one more calibrated batch is run under them
+template <typename F>
+void bench(vector<BenchmarkResult>& results, const string& name, int rowsA, int colsA, int colsB, F&& func, BenchSession& session) {
+    BenchmarkStats stats = run_benchmark(func, session.options);
+    results.push_back(make_result(name, rowsA, colsA, colsB, stats));
+    if (session.counters.available()) {
+        session.counter_rows.push_back({name, rowsA, colsA, colsB, session.counters.measure(func, stats.iterations)});
+    }
+}
+
+void print_counter_table(const BenchSession& session) {
+    if (!session.counters.available()) {
+        cout << "\nHardware counters unavailable (perf_event_open failed; see /proc/sys/kernel/perf_event_paranoid)\n";
+        return;
+    }
+    // An "op" is one multiply-add term (rowsA * colsA * colsB) or, for the
+    // transposes, one element moved
+    cout << "\n--- Hardware Counters (per op) ---\n";
+    cout << left << setw(30) << "Function"
+         << setw(8) << "RowsA"
+         << setw(8) << "ColsA"
+         << setw(8) << "ColsB"
+         << right << setw(8) << "IPC"
+         << setw(12) << "L1d miss"
+         << setw(12) << "LLC miss"
+         << setw(12) << "Br miss"
+         << setw(12) << "dTLB miss"
+         << endl;
+    cout << string(110, '-') << endl;
+    for (const auto& row : session.counter_rows) {
+        double ops = static_cast<double>(row.rowsA) * row.colsA * std::max(row.colsB, 1);
+        auto cell = [&](PerfEvent event) {
+            std::ostringstream text;
+            if (row.sample.has(event)) {
+                text << std::fixed << std::setprecision(4) << row.sample.per_op(event, ops);
+            } else {
+                text << "n/a";
+            }
+            return text.str();
+        };
+        cout << left << setw(30) << row.name
+             << setw(8) << row.rowsA
+             << setw(8) << row.colsA
+             << setw(8) << row.colsB
+             << right << setw(8) << row.sample.ipc()
+             << setw(12) << cell(PerfEvent::L1DMisses)
+             << setw(12) << cell(PerfEvent::LLCMisses)
+             << setw(12) << cell(PerfEvent::BranchMisses)
+             << setw(12) << cell(PerfEvent::DTLBMisses)
+             << endl;
+    }
+    cout << string(110, '-') << endl;
+}
+
 bool test_mv_row_major() {
     cout << "\n--- Testing multiply_mv_row_major ---" << endl;
     const int rows = 2;
@@ -249,6 +355,715 @@ bool test_mm_optimized() {
     return success;
 }
 
+bool test_mm_packed() {
+    cout << "\n--- Testing multiply_mm_packed (" << gemm_kernel_name() << " kernel) ---\n" << endl;
+    const int rowsA = 3;
+    const int colsA = 3;
+    const int rowsB = 3;
+    const int colsB = 2;
+    const double matrixA[] = {
+        1.0, 2.0, 1.0,
+        0.0, 1.0, 0.0,
+        2.0, 3.0, 4.0
+    };
+    const double matrixB[] = {
+        2.0, 5.0,
+        6.0, 7.0,
+        1.0, 8.0
+    };
+    const double expected_res[] = {
+        15.0, 27.0,
+        6.0, 7.0,
+        26.0, 63.0
+    };
+    double actual_res[rowsA * colsB];
+
+    bool success = true;
+    try {
+        multiply_mm_packed(matrixA, rowsA, colsA, matrixB, rowsB, colsB, actual_res);
+        success = check_result("multiply_mm_packed correctness", actual_res, expected_res, rowsA * colsB);
+
+        // Sizes that are not multiples of the micro-tile exercise the edge-tile path
+        const int m = 67, k = 301, n = 45;
+        vector<double> bigA = generate_random_matrix(m, k);
+        vector<double> bigB = generate_random_matrix(k, n);
+        vector<double> expected(m * n), actual(m * n);
+        multiply_mm_naive(bigA.data(), m, k, bigB.data(), k, n, expected.data());
+        multiply_mm_packed(bigA.data(), m, k, bigB.data(), k, n, actual.data());
+        success &= check_result("multiply_mm_packed edge tiles", actual.data(), expected.data(), m * n, 1e-9 * k);
+    }
+    catch (const std::exception& e) {
+        cerr << "Test Failed: multiply_mm_packed threw unexpected exception: " << e.what() << endl;
+        success = false;
+    }
+
+    return success;
+}
+
+bool test_mm_tiled_configs() {
+    cout << "\n--- Testing multiply_mm_tiled configurations ---\n" << endl;
+    const int m = 53, k = 77, n = 41;
+    vector<double> A = generate_random_matrix(m, k);
+    vector<double> B = generate_random_matrix(k, n);
+    vector<double> expected(m * n), actual(m * n);
+
+    bool success = true;
+    try {
+        multiply_mm_naive(A.data(), m, k, B.data(), k, n, expected.data());
+        // Block sizes that don't divide the problem, in both loop orders
+        for (TileLoopOrder order : {TileLoopOrder::IKJ, TileLoopOrder::KIJ}) {
+            TileConfig config{7, 5, 16, order};
+            multiply_mm_tiled(A.data(), m, k, B.data(), k, n, actual.data(), config);
+            string name = string("multiply_mm_tiled ") + (order == TileLoopOrder::IKJ ? "ikj" : "kij");
+            success &= check_result(name.c_str(), actual.data(), expected.data(), m * n);
+        }
+    }
+    catch (const std::exception& e) {
+        cerr << "Test Failed: multiply_mm_tiled threw unexpected exception: " << e.what() << endl;
+        success = false;
+    }
+
+    return success;
+}
+
+bool test_matrix_views() {
+    cout << "\n--- Testing Matrix views ---\n" << endl;
+    // Operands are sub-blocks of larger padded matrices, so every kernel sees ld != cols
+    const int m = 37, k = 41, n = 29;
+    Matrix<double> bigA = generate_random_matrix_aligned<Layout::RowMajor>(m + 5, k + 9);
+    Matrix<double> bigB = generate_random_matrix_aligned<Layout::RowMajor>(k + 3, n + 11);
+    Matrix<double> bigC(m + 4, n + 6);
+    ConstMatrixView A = std::as_const(bigA).block(3, 5, m, k);
+    ConstMatrixView B = std::as_const(bigB).block(2, 7, k, n);
+    MutableMatrixView C = bigC.block(1, 2, m, n);
+
+    // Dense copies for the reference result
+    vector<double> denseA(m * k), denseB(k * n), expected(m * n), actual(m * n);
+    for (int i = 0; i < m; ++i) for (int j = 0; j < k; ++j) denseA[i * k + j] = A(i, j);
+    for (int i = 0; i < k; ++i) for (int j = 0; j < n; ++j) denseB[i * n + j] = B(i, j);
+    multiply_mm_naive(denseA.data(), m, k, denseB.data(), k, n, expected.data());
+
+    const double sentinel = -12345.0;
+    auto reset_c = [&]() {
+        for (int i = 0; i < bigC.rows(); ++i) for (int j = 0; j < bigC.cols(); ++j) bigC(i, j) = sentinel;
+    };
+    auto check_c = [&](const char* name) {
+        bool ok = true;
+        for (int i = 0; i < bigC.rows(); ++i) {
+            for (int j = 0; j < bigC.cols(); ++j) {
+                bool inside = i >= 1 && i < 1 + m && j >= 2 && j < 2 + n;
+                if (!inside && bigC(i, j) != sentinel) ok = false;
+                if (inside) actual[(i - 1) * n + (j - 2)] = bigC(i, j);
+            }
+        }
+        if (!ok) {
+            cerr << "Test Failed: " << name << " wrote outside the result view" << endl;
+            return false;
+        }
+        return check_result(name, actual.data(), expected.data(), m * n, 1e-9 * k);
+    };
+
+    bool success = true;
+    try {
+        for (int i = 0; i < bigA.rows(); ++i) {
+            if (reinterpret_cast<std::uintptr_t>(bigA.view().line(i)) % 64 != 0) {
+                cerr << "Test Failed: Matrix row " << i << " is not 64-byte aligned" << endl;
+                success = false;
+            }
+        }
+
+        reset_c();
+        multiply_mm_naive(A, B, C);
+        success &= check_c("multiply_mm_naive (view)");
+
+        Matrix<double> bigB_T(n + 2, k + 1);
+        for (int i = 0; i < k; ++i) for (int j = 0; j < n; ++j) bigB_T(j + 1, i) = B(i, j);
+        reset_c();
+        multiply_mm_transposed_b(A, std::as_const(bigB_T).block(1, 0, n, k), C);
+        success &= check_c("multiply_mm_transposed_b (view)");
+
+        reset_c();
+        multiply_mm_optimized(A, B, C);
+        success &= check_c("multiply_mm_optimized (view)");
+
+        reset_c();
+        multiply_mm_packed(A, B, C);
+        success &= check_c("multiply_mm_packed (view)");
+
+        ThreadPool pool(3);
+        reset_c();
+        multiply_mm_packed_parallel(A, B, C, pool, 8);
+        success &= check_c("multiply_mm_packed_parallel (view)");
+
+        // GEMV on the same block in both layouts
+        vector<double> x = generate_random_vector(k), y_expected(m), y(m);
+        multiply_mv_row_major(denseA.data(), m, k, x.data(), y_expected.data());
+        multiply_mv_row_major(A, x.data(), y.data());
+        success &= check_result("multiply_mv_row_major (view)", y.data(), y_expected.data(), m);
+
+        Matrix<double, Layout::ColMajor> bigA_col(m + 2, k + 2);
+        for (int i = 0; i < m; ++i) for (int j = 0; j < k; ++j) bigA_col(i + 2, j + 1) = A(i, j);
+        multiply_mv_col_major(std::as_const(bigA_col).block(2, 1, m, k), x.data(), y.data());
+        success &= check_result("multiply_mv_col_major (view)", y.data(), y_expected.data(), m);
+    }
+    catch (const std::exception& e) {
+        cerr << "Test Failed: Matrix view kernels threw unexpected exception: " << e.what() << endl;
+        success = false;
+    }
+
+    return success;
+}
+
+bool test_precisions() {
+    cout << "\n--- Testing float / mixed-precision kernels ---\n" << endl;
+    const int m = 67, k = 300, n = 45;
+    Matrix<float> A(m, k), B(k, n), C(m, n);
+    Matrix<float, Layout::ColMajor> A_col(m, k);
+    vector<double> denseA(m * k), denseB(k * n), expected(m * n), expected_mv(m);
+    vector<float> x(k), y(m);
+    vector<double> x_double(k);
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> distrib(0.0f, 1.0f);
+    for (int i = 0; i < m; ++i) for (int j = 0; j < k; ++j) denseA[i * k + j] = A_col(i, j) = A(i, j) = distrib(gen);
+    for (int i = 0; i < k; ++i) for (int j = 0; j < n; ++j) denseB[i * n + j] = B(i, j) = distrib(gen);
+    for (int i = 0; i < k; ++i) x_double[i] = x[i] = distrib(gen);
+
+    // Reference in double from the exact float inputs
+    multiply_mm_naive(denseA.data(), m, k, denseB.data(), k, n, expected.data());
+    multiply_mv_row_major(denseA.data(), m, k, x_double.data(), expected_mv.data());
+    double mag_mm = *std::max_element(expected.begin(), expected.end());
+    double mag_mv = *std::max_element(expected_mv.begin(), expected_mv.end());
+    // The packed mixed kernel rounds C to float once per kc panel (kc >= 64)
+    int panels = (k + 63) / 64;
+
+    bool success = true;
+    try {
+        gemm_tiled<float>(A, B, C);
+        vector<float> flat(m * n);
+        auto flatten = [&]() {
+            for (int i = 0; i < m; ++i) std::copy_n(C.view().line(i), n, flat.data() + i * n);
+            return flat.data();
+        };
+        success &= check_result("gemm_tiled<float> error bound", flatten(), expected.data(), m * n, error_bound<float, float>(k, mag_mm));
+
+        gemm_tiled<float, double>(A, B, C);
+        success &= check_result("gemm_tiled<float,double> error bound", flatten(), expected.data(), m * n, error_bound<float, double>(k, mag_mm));
+
+        gemm_packed<float>(A, B, C);
+        success &= check_result("gemm_packed<float> error bound", flatten(), expected.data(), m * n, error_bound<float, float>(k, mag_mm));
+
+        gemm_packed<float, double>(A, B, C);
+        success &= check_result("gemm_packed<float,double> error bound", flatten(), expected.data(), m * n, error_bound<float, double>(k, mag_mm, panels));
+
+        gemv_row_major<float>(A, x.data(), y.data());
+        success &= check_result("gemv_row_major<float> error bound", y.data(), expected_mv.data(), m, error_bound<float, float>(k, mag_mv));
+
+        gemv_row_major<float, double>(A, x.data(), y.data());
+        success &= check_result("gemv_row_major<float,double> error bound", y.data(), expected_mv.data(), m, error_bound<float, double>(k, mag_mv));
+
+        gemv_col_major<float, double>(A_col, x.data(), y.data());
+        success &= check_result("gemv_col_major<float,double> error bound", y.data(), expected_mv.data(), m, error_bound<float, double>(k, mag_mv));
+
+        Matrix<double> Ad(m, k), Bd(k, n), Cd(m, n);
+        for (int i = 0; i < m; ++i) for (int j = 0; j < k; ++j) Ad(i, j) = denseA[i * k + j];
+        for (int i = 0; i < k; ++i) for (int j = 0; j < n; ++j) Bd(i, j) = denseB[i * n + j];
+        gemm_packed<double>(Ad, Bd, Cd);
+        vector<double> flat_d(m * n);
+        for (int i = 0; i < m; ++i) std::copy_n(Cd.view().line(i), n, flat_d.data() + i * n);
+        success &= check_result("gemm_packed<double> error bound", flat_d.data(), expected.data(), m * n, error_bound<double, double>(k, mag_mm));
+    }
+    catch (const std::exception& e) {
+        cerr << "Test Failed: precision kernels threw unexpected exception: " << e.what() << endl;
+        success = false;
+    }
+
+    return success;
+}
+
+bool test_parallel_kernels() {
+    cout << "\n--- Testing parallel kernels ---\n" << endl;
+    const int m = 131, k = 70, n = 93;
+    const int grain = 16;
+    vector<double> A = generate_random_matrix(m, k);
+    vector<double> B = generate_random_matrix(k, n);
+    vector<double> B_T = transpose_matrix(B, k, n);
+    vector<double> A_col_major = transpose_matrix(A, m, k);
+    vector<double> x = generate_random_vector(k);
+    vector<double> expected_mv(m), actual_mv(m);
+    vector<double> expected_mm(m * n), actual_mm(m * n);
+
+    bool success = true;
+    try {
+        ThreadPool pool(4);
+        multiply_mv_row_major(A.data(), m, k, x.data(), expected_mv.data());
+        multiply_mm_naive(A.data(), m, k, B.data(), k, n, expected_mm.data());
+
+        multiply_mv_row_major_parallel(A.data(), m, k, x.data(), actual_mv.data(), pool, grain);
+        success &= check_result("multiply_mv_row_major_parallel", actual_mv.data(), expected_mv.data(), m);
+        multiply_mv_col_major_parallel(A_col_major.data(), m, k, x.data(), actual_mv.data(), pool, grain);
+        success &= check_result("multiply_mv_col_major_parallel", actual_mv.data(), expected_mv.data(), m);
+
+        multiply_mm_naive_parallel(A.data(), m, k, B.data(), k, n, actual_mm.data(), pool, grain);
+        success &= check_result("multiply_mm_naive_parallel", actual_mm.data(), expected_mm.data(), m * n);
+        multiply_mm_transposed_b_parallel(A.data(), m, k, B_T.data(), n, k, actual_mm.data(), pool, grain);
+        success &= check_result("multiply_mm_transposed_b_parallel", actual_mm.data(), expected_mm.data(), m * n);
+        multiply_mm_optimized_parallel(A.data(), m, k, B.data(), k, n, actual_mm.data(), pool, grain);
+        success &= check_result("multiply_mm_optimized_parallel", actual_mm.data(), expected_mm.data(), m * n);
+        // Chunks follow the tuned block_i, which need not be 64
+        TileConfig saved_config = tile_config();
+        TileConfig odd_config = saved_config;
+        odd_config.block_i = 24;
+        set_tile_config(odd_config);
+        multiply_mm_optimized_parallel(A.data(), m, k, B.data(), k, n, actual_mm.data(), pool, grain);
+        set_tile_config(saved_config);
+        success &= check_result("multiply_mm_optimized_parallel (24-row blocks)", actual_mm.data(), expected_mm.data(), m * n);
+        multiply_mm_packed_parallel(A.data(), m, k, B.data(), k, n, actual_mm.data(), pool, grain);
+        success &= check_result("multiply_mm_packed_parallel", actual_mm.data(), expected_mm.data(), m * n);
+
+        // Tile-rounded chunks must still cover every row of an uninitialised buffer
+        std::unique_ptr<double[]> fresh(new double[m * n]);
+        first_touch_parallel(fresh.get(), m, n, pool, grain, 64);
+        vector<double> zeros(m * n, 0.0);
+        success &= check_result("first_touch_parallel (64-row tiles)", fresh.get(), zeros.data(), m * n);
+    }
+    catch (const std::exception& e) {
+        cerr << "Test Failed: parallel kernels threw unexpected exception: " << e.what() << endl;
+        success = false;
+    }
+
+    return success;
+}
+
+// Thread counts 1, 2, 4, ... up to the machine's hardware concurrency (always included)
+vector<unsigned> scaling_thread_counts() {
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    vector<unsigned> counts;
+    for (unsigned t = 1; t < hw; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(hw);
+    return counts;
+}
+
+// Partitioned operands of the scaling benchmarks are allocated uninitialised,
+// so none of their pages is faulted until first_touch_parallel runs
+using UninitBuffer = std::unique_ptr<double[]>;
+
+void run_scaling_benchmarks(const BenchmarkOptions& options) {
+    const int gemv_n = 4096;
+    const int gemm_n = 1000;
+    const vector<double> M = generate_random_matrix(gemv_n, gemv_n);
+    const vector<double> x = generate_random_vector(gemv_n);
+    const vector<double> A = generate_random_matrix(gemm_n, gemm_n);
+    const vector<double> B = generate_random_matrix(gemm_n, gemm_n);
+
+    // Each thread reads its band of rows of `input` (M or A) and writes the
+    // same rows of the output; x and B are read by every thread and stay put
+    struct Kernel {
+        const char* name;
+        double flops;
+        const vector<double>* input;
+        bool input_col_major;
+        int rows;
+        int input_cols;
+        int output_cols;
+        int tile_rows;
+        std::function<void(ThreadPool&, const double*, double*)> run;
+    };
+    vector<Kernel> kernels = {
+        {"mv_row_major_parallel", 2.0 * gemv_n * gemv_n, &M, false, gemv_n, gemv_n, 1, 1,
+         [&](ThreadPool& pool, const double* in, double* out) {
+            multiply_mv_row_major_parallel(in, gemv_n, gemv_n, x.data(), out, pool);
+        }},
+        {"mv_col_major_parallel", 2.0 * gemv_n * gemv_n, &M, true, gemv_n, gemv_n, 1, 1,
+         [&](ThreadPool& pool, const double* in, double* out) {
+            multiply_mv_col_major_parallel(in, gemv_n, gemv_n, x.data(), out, pool);
+        }},
+        {"mm_optimized_parallel", 2.0 * gemm_n * gemm_n * gemm_n, &A, false, gemm_n, gemm_n, gemm_n, tile_config().block_i,
+         [&](ThreadPool& pool, const double* in, double* out) {
+            multiply_mm_optimized_parallel(in, gemm_n, gemm_n, B.data(), gemm_n, gemm_n, out, pool);
+        }},
+        {"mm_packed_parallel", 2.0 * gemm_n * gemm_n * gemm_n, &A, false, gemm_n, gemm_n, gemm_n, 6,
+         [&](ThreadPool& pool, const double* in, double* out) {
+            multiply_mm_packed_parallel(in, gemm_n, gemm_n, B.data(), gemm_n, gemm_n, out, pool);
+        }},
+    };
+
+    cout << "\n--- Thread Scaling (GEMV " << gemv_n << "x" << gemv_n << ", GEMM " << gemm_n << "^3, "
+         << "median of adaptive runs) ---\n";
+    cout << left << setw(28) << "Function"
+         << right << setw(8) << "Threads"
+         << setw(15) << "Median (ms)"
+         << setw(12) << "GFLOP/s"
+         << setw(10) << "Speedup"
+         << setw(12) << "Efficiency"
+         << endl;
+    cout << string(85, '-') << endl;
+
+    for (const auto& kernel : kernels) {
+        double baseline_ms = 0.0;
+        for (unsigned threads : scaling_thread_counts()) {
+            ThreadPool pool(threads, true);
+            UninitBuffer input(new double[static_cast<size_t>(kernel.rows) * kernel.input_cols]);
+            UninitBuffer output(new double[static_cast<size_t>(kernel.rows) * kernel.output_cols]);
+            if (kernel.input_col_major) {
+                // Row band [lo, hi) of a column-major matrix is a strip of every column
+                pool.parallel_for(0, kernel.rows, 0, [&](int lo, int hi) {
+                    for (int c = 0; c < kernel.input_cols; ++c) {
+                        std::fill(&input[static_cast<size_t>(c) * kernel.rows + lo], &input[static_cast<size_t>(c) * kernel.rows + hi], 0.0);
+                    }
+                });
+            } else {
+                first_touch_parallel(input.get(), kernel.rows, kernel.input_cols, pool, 0, kernel.tile_rows);
+            }
+            first_touch_parallel(output.get(), kernel.rows, kernel.output_cols, pool, 0, kernel.tile_rows);
+            std::copy(kernel.input->begin(), kernel.input->end(), input.get());  // pages are already placed
+
+            double median_ms = run_benchmark([&]() { kernel.run(pool, input.get(), output.get()); }, options).median_ms;
+            if (threads == 1) {
+                baseline_ms = median_ms;
+            }
+            double speedup = median_ms > 0.0 ? baseline_ms / median_ms : 0.0;
+            cout << left << setw(28) << kernel.name
+                 << right << setw(8) << threads
+                 << setw(15) << median_ms
+                 << setw(12) << kernel.flops / (median_ms * 1e6)
+                 << setw(10) << speedup
+                 << setw(12) << speedup / threads
+                 << endl;
+        }
+    }
+    cout << string(85, '-') << endl;
+}
+
+bool test_transpose() {
+    cout << "\n--- Testing transpose / transpose_in_place ---\n" << endl;
+    bool success = true;
+    try {
+        // Odd and non-multiple-of-4 shapes exercise the scalar edges of every split
+        const int shapes[][2] = {{1, 1}, {3, 7}, {37, 53}, {64, 64}, {129, 67}, {200, 33}};
+        for (const auto& shape : shapes) {
+            int rows = shape[0], cols = shape[1];
+            vector<double> src = generate_random_matrix<vector<double>>(rows, cols);
+            vector<double> expected(rows * cols), dst(rows * cols);
+            transpose_naive(src.data(), rows, cols, expected.data());
+            transpose(src.data(), rows, cols, cols, dst.data(), rows);
+            success &= check_result(("transpose " + std::to_string(rows) + "x" + std::to_string(cols)).c_str(), dst.data(), expected.data(), rows * cols);
+        }
+
+        // Padded storage and a sub-block view
+        Matrix<double> M = generate_random_matrix_aligned<Layout::RowMajor>(45, 70);
+        Matrix<double> MT(70, 45);
+        transpose(M, MT);
+        bool view_ok = true;
+        for (int i = 0; i < 45; ++i) for (int j = 0; j < 70; ++j) view_ok &= MT(j, i) == M(i, j);
+        Matrix<double> BT(20, 10);
+        transpose(M.block(5, 30, 10, 20), BT);
+        for (int i = 0; i < 10; ++i) for (int j = 0; j < 20; ++j) view_ok &= BT(j, i) == M(5 + i, 30 + j);
+        cout << (view_ok ? "transpose (Matrix views): Passed" : "transpose (Matrix views): Failed") << endl;
+        success &= view_ok;
+
+        for (int n : {1, 5, 32, 33, 100, 131}) {
+            vector<double> a = generate_random_matrix<vector<double>>(n, n);
+            vector<double> expected(n * n);
+            transpose_naive(a.data(), n, n, expected.data());
+            transpose_in_place(a.data(), n, n);
+            success &= check_result(("transpose_in_place " + std::to_string(n)).c_str(), a.data(), expected.data(), n * n);
+        }
+
+        Matrix<double> S = generate_random_matrix_aligned<Layout::RowMajor>(50, 50);
+        Matrix<double> S_orig = S;
+        transpose_in_place(S);
+        bool in_place_ok = true;
+        for (int i = 0; i < 50; ++i) for (int j = 0; j < 50; ++j) in_place_ok &= S(j, i) == S_orig(i, j);
+        cout << (in_place_ok ? "transpose_in_place (Matrix): Passed" : "transpose_in_place (Matrix): Failed") << endl;
+        success &= in_place_ok;
+    }
+    catch (const std::exception& e) {
+        cerr << "Test Failed: transpose threw unexpected exception: " << e.what() << endl;
+        success = false;
+    }
+
+    try {
+        Matrix<double> R(3, 4);
+        transpose_in_place(R);
+        cerr << "Test Failed: transpose_in_place did not throw for a non-square matrix." << endl;
+        success = false;
+    }
+    catch (const std::invalid_argument& e) {
+        cout << "transpose_in_place (non-square): Passed (Caught expected exception: " << e.what() << ")" << endl;
+    }
+
+    return success;
+}
+
+bool test_batched_gemm() {
+    cout << "\n--- Testing gemm_batched / gemm_batched_strided / gemm_batched_interleaved ---\n" << endl;
+    bool success = true;
+    try {
+        // 5 and 12x7x9 take the runtime-bounds kernel, the squares the fixed-size ones;
+        // 37 products leave a partial interleaved group
+        const int shapes[][3] = {{5, 5, 5}, {8, 8, 8}, {16, 16, 16}, {24, 24, 24}, {32, 32, 32}, {12, 7, 9}};
+        const int count = 37;
+        for (const auto& shape : shapes) {
+            int m = shape[0], k = shape[1], n = shape[2];
+            string label = std::to_string(m) + "x" + std::to_string(k) + "x" + std::to_string(n);
+            vector<double> A = generate_random_vector(count * m * k);
+            vector<double> B = generate_random_vector(count * k * n);
+            vector<double> expected(count * m * n), C(count * m * n);
+            for (int b = 0; b < count; ++b) {
+                multiply_mm_naive(A.data() + b * m * k, m, k, B.data() + b * k * n, k, n, expected.data() + b * m * n);
+            }
+
+            gemm_batched_strided(A.data(), m * k, B.data(), k * n, C.data(), m * n, count, m, k, n);
+            success &= check_result(("gemm_batched_strided " + label).c_str(), C.data(), expected.data(), C.size());
+
+            std::fill(C.begin(), C.end(), 0.0);
+            vector<GemmTriple> items(count);
+            for (int b = 0; b < count; ++b) {
+                items[b] = {A.data() + b * m * k, B.data() + b * k * n, C.data() + b * m * n};
+            }
+            gemm_batched(items.data(), count, m, k, n);
+            success &= check_result(("gemm_batched " + label).c_str(), C.data(), expected.data(), C.size());
+
+            vector<double> Ai(interleaved_size(count, m, k)), Bi(interleaved_size(count, k, n)), Ci(interleaved_size(count, m, n));
+            interleave_batch(A.data(), m * k, count, m, k, Ai.data());
+            interleave_batch(B.data(), k * n, count, k, n, Bi.data());
+            gemm_batched_interleaved(Ai.data(), Bi.data(), Ci.data(), count, m, k, n);
+            std::fill(C.begin(), C.end(), 0.0);
+            deinterleave_batch(Ci.data(), count, m, n, C.data(), m * n);
+            success &= check_result(("gemm_batched_interleaved " + label).c_str(), C.data(), expected.data(), C.size());
+        }
+    }
+    catch (const std::exception& e) {
+        cerr << "Test Failed: batched GEMM threw unexpected exception: " << e.what() << endl;
+        success = false;
+    }
+
+    try {
+        double a = 0.0;
+        gemm_batched_strided(&a, 1, nullptr, 1, &a, 1, 1, 1, 1, 1);
+        cerr << "Test Failed: gemm_batched_strided did not throw for a null matrix." << endl;
+        success = false;
+    }
+    catch (const std::invalid_argument& e) {
+        cout << "gemm_batched_strided (null B): Passed (Caught expected exception: " << e.what() << ")" << endl;
+    }
+
+    return success;
+}
+
+// Per-instrument models: many tiny products. Looping multiply_mm_optimized pays
+// its checks and tiling per product; the batched kernels pay them once
+void run_batched_benchmarks(const BenchmarkOptions& options) {
+    const int count = 4096;
+    cout << "\n--- Batched small GEMM (" << count << " products, kernel: " << gemm_batched_kernel_name()
+         << ", median of adaptive runs) ---\n";
+    cout << left << setw(28) << "Function"
+         << right << setw(8) << "Size"
+         << setw(15) << "Median (ms)"
+         << setw(12) << "GFLOP/s"
+         << endl;
+    cout << string(63, '-') << endl;
+
+    for (int s : {4, 8, 16, 32}) {
+        const int elems = s * s;
+        vector<double> A = generate_random_vector(count * elems);
+        vector<double> B = generate_random_vector(count * elems);
+        vector<double> C(count * elems);
+        vector<double> Ai(interleaved_size(count, s, s)), Bi(interleaved_size(count, s, s)), Ci(interleaved_size(count, s, s));
+        interleave_batch(A.data(), elems, count, s, s, Ai.data());
+        interleave_batch(B.data(), elems, count, s, s, Bi.data());
+
+        struct Kernel {
+            const char* name;
+            std::function<void()> run;
+        };
+        vector<Kernel> kernels = {
+            {"mm_optimized (per product)", [&]() {
+                for (int b = 0; b < count; ++b) {
+                    multiply_mm_optimized(A.data() + b * elems, s, s, B.data() + b * elems, s, s, C.data() + b * elems);
+                }
+            }},
+            {"gemm_batched_strided", [&]() {
+                gemm_batched_strided(A.data(), elems, B.data(), elems, C.data(), elems, count, s, s, s);
+            }},
+            {"gemm_batched_interleaved", [&]() {
+                gemm_batched_interleaved(Ai.data(), Bi.data(), Ci.data(), count, s, s, s);
+            }},
+        };
+        const double flops = 2.0 * count * s * s * s;
+        for (const auto& kernel : kernels) {
+            double median_ms = run_benchmark(kernel.run, options).median_ms;
+            cout << left << setw(28) << kernel.name
+                 << right << setw(8) << s
+                 << setw(15) << median_ms
+                 << setw(12) << (median_ms > 0.0 ? flops / (median_ms * 1e6) : 0.0)
+                 << endl;
+        }
+    }
+    cout << string(63, '-') << endl;
+}
+
+// Dense row-major matrix whose cluster x cluster tiles are each non-zero with
+// probability `density` (cluster 1: independent entries)
+vector<double> generate_sparse_matrix(int rows, int cols, double density, unsigned seed, int cluster = 1) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<> value(0.0, 1.0);
+    std::bernoulli_distribution keep(density);
+    vector<double> m(static_cast<size_t>(rows) * cols, 0.0);
+    for (int i0 = 0; i0 < rows; i0 += cluster) {
+        for (int j0 = 0; j0 < cols; j0 += cluster) {
+            if (!keep(gen)) {
+                continue;
+            }
+            for (int i = i0; i < std::min(i0 + cluster, rows); ++i) {
+                for (int j = j0; j < std::min(j0 + cluster, cols); ++j) {
+                    m[static_cast<size_t>(i) * cols + j] = value(gen);
+                }
+            }
+        }
+    }
+    return m;
+}
+
+bool test_sparse() {
+    cout << "\n--- Testing CSR / BSR spmv and spmm ---\n" << endl;
+    bool success = true;
+    try {
+        ThreadPool pool(4);
+        // 37x53 leaves partial edge blocks; density 0 gives empty rows everywhere
+        const int shapes[][2] = {{1, 1}, {37, 53}, {64, 64}, {130, 71}};
+        const int colsB = 7;
+        for (const auto& shape : shapes) {
+            for (double density : {0.0, 0.05, 0.3, 1.0}) {
+                int rows = shape[0], cols = shape[1];
+                string label = std::to_string(rows) + "x" + std::to_string(cols) + " @" + std::to_string(density).substr(0, 4);
+                vector<double> dense = generate_sparse_matrix(rows, cols, density, 42u);
+                vector<double> x = generate_random_vector(cols);
+                vector<double> B = generate_random_matrix(cols, colsB);
+                vector<double> y_expected(rows), y(rows), C_expected(rows * colsB), C(rows * colsB);
+                multiply_mv_row_major(dense.data(), rows, cols, x.data(), y_expected.data());
+                multiply_mm_naive(dense.data(), rows, cols, B.data(), cols, colsB, C_expected.data());
+
+                CsrMatrix csr = dense_to_csr(dense.data(), rows, cols);
+                BsrMatrix bsr = dense_to_bsr(dense.data(), rows, cols);
+                size_t expected_nnz = std::count_if(dense.begin(), dense.end(), [](double v) { return v != 0.0; });
+                if (csr.nnz() != expected_nnz) {
+                    cerr << "Test Failed: dense_to_csr " << label << " kept " << csr.nnz() << " of " << expected_nnz << " non-zeros" << endl;
+                    success = false;
+                }
+
+                spmv(csr, x.data(), y.data());
+                success &= check_result(("spmv CSR " + label).c_str(), y.data(), y_expected.data(), rows);
+                spmv(bsr, x.data(), y.data());
+                success &= check_result(("spmv BSR " + label).c_str(), y.data(), y_expected.data(), rows);
+                spmv_parallel(csr, x.data(), y.data(), pool);
+                success &= check_result(("spmv_parallel CSR " + label).c_str(), y.data(), y_expected.data(), rows);
+                spmv_parallel(bsr, x.data(), y.data(), pool);
+                success &= check_result(("spmv_parallel BSR " + label).c_str(), y.data(), y_expected.data(), rows);
+
+                spmm(csr, B.data(), colsB, C.data());
+                success &= check_result(("spmm CSR " + label).c_str(), C.data(), C_expected.data(), C.size());
+                spmm(bsr, B.data(), colsB, C.data());
+                success &= check_result(("spmm BSR " + label).c_str(), C.data(), C_expected.data(), C.size());
+                spmm_parallel(csr, B.data(), colsB, C.data(), pool);
+                success &= check_result(("spmm_parallel CSR " + label).c_str(), C.data(), C_expected.data(), C.size());
+                spmm_parallel(bsr, B.data(), colsB, C.data(), pool);
+                success &= check_result(("spmm_parallel BSR " + label).c_str(), C.data(), C_expected.data(), C.size());
+            }
+        }
+
+        // Conversion from a padded sub-block view, with a drop tolerance
+        Matrix<double> M = generate_random_matrix_aligned<Layout::RowMajor>(20, 30);
+        ConstMatrixView sub = M.block(3, 4, 10, 12);
+        CsrMatrix csr = dense_to_csr(sub, 0.5);
+        bool view_ok = csr.rows == 10 && csr.cols == 12;
+        for (int i = 0; i < 10; ++i) {
+            int e = csr.row_ptr[i];
+            for (int j = 0; j < 12; ++j) {
+                if (sub(i, j) > 0.5) {
+                    view_ok &= e < csr.row_ptr[i + 1] && csr.col_idx[e] == j && csr.values[e] == sub(i, j);
+                    ++e;
+                }
+            }
+            view_ok &= e == csr.row_ptr[i + 1];
+        }
+        cout << (view_ok ? "dense_to_csr (view, tolerance): Passed" : "dense_to_csr (view, tolerance): Failed") << endl;
+        success &= view_ok;
+    }
+    catch (const std::exception& e) {
+        cerr << "Test Failed: sparse kernels threw unexpected exception: " << e.what() << endl;
+        success = false;
+    }
+
+    try {
+        CsrMatrix csr = dense_to_csr(vector<double>(4, 1.0).data(), 2, 2);
+        double y[2];
+        spmv(csr, nullptr, y);
+        cerr << "Test Failed: spmv did not throw for a null vector." << endl;
+        success = false;
+    }
+    catch (const std::invalid_argument& e) {
+        cout << "spmv (null vector): Passed (Caught expected exception: " << e.what() << ")" << endl;
+    }
+
+    return success;
+}
+
+// SpMV against the dense row-major GEMV on the same matrix. Scattered
+// non-zeros are the worst case for BSR (its fill ratio is the number of stored
+// values per real non-zero); 4x4 clustered ones are its best case.
+void run_sparse_benchmarks(const BenchmarkOptions& options) {
+    const int n = 2048;
+    ThreadPool pool;
+    vector<double> x = generate_random_vector(n);
+    vector<double> y(n);
+
+    cout << "\n--- Sparse matrix-vector (" << n << "x" << n << ", " << pool.size() << " threads for _parallel, "
+         << "median of adaptive runs) ---\n";
+    cout << left << setw(10) << "Density"
+         << setw(11) << "Pattern"
+         << right << setw(10) << "NNZ"
+         << setw(14) << "Dense (ms)"
+         << setw(12) << "CSR (ms)"
+         << setw(14) << "CSR par (ms)"
+         << setw(12) << "BSR (ms)"
+         << setw(14) << "BSR par (ms)"
+         << setw(10) << "BSR fill"
+         << setw(12) << "CSR speedup"
+         << endl;
+    cout << string(119, '-') << endl;
+
+    const std::pair<double, int> cases[] = {{0.001, 1}, {0.01, 1}, {0.05, 1}, {0.1, 1}, {0.25, 1}, {0.5, 1},
+                                            {0.01, 4}, {0.05, 4}, {0.25, 4}};
+    for (auto [density, cluster] : cases) {
+        vector<double> dense = generate_sparse_matrix(n, n, density, 7u, cluster);
+        CsrMatrix csr = dense_to_csr(dense.data(), n, n);
+        BsrMatrix bsr = dense_to_bsr(dense.data(), n, n);
+
+        double dense_ms = run_benchmark([&]() { multiply_mv_row_major(dense.data(), n, n, x.data(), y.data()); }, options).median_ms;
+        double csr_ms = run_benchmark([&]() { spmv(csr, x.data(), y.data()); }, options).median_ms;
+        double csr_par_ms = run_benchmark([&]() { spmv_parallel(csr, x.data(), y.data(), pool); }, options).median_ms;
+        double bsr_ms = run_benchmark([&]() { spmv(bsr, x.data(), y.data()); }, options).median_ms;
+        double bsr_par_ms = run_benchmark([&]() { spmv_parallel(bsr, x.data(), y.data(), pool); }, options).median_ms;
+
+        cout << left << setw(10) << density
+             << setw(11) << (cluster == 1 ? "scattered" : "4x4 tiles")
+             << right << setw(10) << csr.nnz()
+             << setw(14) << dense_ms
+             << setw(12) << csr_ms
+             << setw(14) << csr_par_ms
+             << setw(12) << bsr_ms
+             << setw(14) << bsr_par_ms
+             << setw(10) << bsr.fill_ratio(csr.nnz())
+             << setw(12) << (csr_ms > 0.0 ? dense_ms / csr_ms : 0.0)
+             << endl;
+    }
+    cout << string(119, '-') << endl;
+}
+
 int main(int argc, char* argv[]) {
     srand(static_cast<unsigned int>(time(nullptr)));
 
@@ -259,6 +1074,14 @@ int main(int argc, char* argv[]) {
     all_tests_passed &= test_mm_naive();
     all_tests_passed &= test_mm_transposed_b();
     all_tests_passed &= test_mm_optimized();
+    all_tests_passed &= test_mm_packed();
+    all_tests_passed &= test_mm_tiled_configs();
+    all_tests_passed &= test_parallel_kernels();
+    all_tests_passed &= test_matrix_views();
+    all_tests_passed &= test_precisions();
+    all_tests_passed &= test_transpose();
+    all_tests_passed &= test_batched_gemm();
+    all_tests_passed &= test_sparse();
 
     if (all_tests_passed) {
         cout << "\n=== All Correctness Tests Passed ===\n" << endl;
@@ -268,8 +1091,30 @@ int main(int argc, char* argv[]) {
     }
 
     cout << "\n=== Testing Program Finished ===\n" << endl;
-    const int num_runs = 10;
-    cout << "Starting benchmarks (" << num_runs << " runs per test):" << endl;
+
+    // --retune ignores the cached tile configuration for this CPU,
+    // --pin <cpu> pins the benchmark thread, --csv/--json <path> export the results
+    bool retune = false;
+    BenchSession session;
+    BenchmarkOptions& options = session.options;
+    string csv_path, json_path;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--retune") {
+            retune = true;
+        } else if (arg == "--pin" && has_value) {
+            options.pin_cpu = std::stoi(argv[++i]);
+        } else if (arg == "--csv" && has_value) {
+            csv_path = argv[++i];
+        } else if (arg == "--json" && has_value) {
+            json_path = argv[++i];
+        }
+    }
+    init_tile_config(retune, true);
+
+    cout << "Starting benchmarks (" << options.warmup_runs << " warmup, " << options.min_runs << "-" << options.max_runs
+         << " runs until the 95% CI is within " << options.target_rel_ci * 100 << "% of the mean):" << endl;
 
     // Define test sizes: {rowsA, colsA (==rowsB), colsB}
     vector<tuple<int, int, int>> test_sizes = {
@@ -281,7 +1126,9 @@ int main(int argc, char* argv[]) {
         {50, 300, 80}      
     };
 
-    bool align = false;
+    // Flip to run every benchmark on 64-byte aligned buffers
+    constexpr bool align = false;
+    using BenchVector = std::conditional_t<align, AlignedVector<double>, vector<double>>;
 
     vector<BenchmarkResult> results;
     for (const auto& sizes : test_sizes) {
@@ -294,31 +1141,42 @@ int main(int argc, char* argv[]) {
 
         try {
             // --- Generate Data ---
-            vector<double> matrixA = generate_random_matrix(rowsA, colsA, align);
-            vector<double> matrixB = generate_random_matrix(rowsB, colsB, align);
-            vector<double> vector_in = generate_random_vector(colsA, align); 
+            BenchVector matrixA = generate_random_matrix<BenchVector>(rowsA, colsA);
+            BenchVector matrixB = generate_random_matrix<BenchVector>(rowsB, colsB);
+            BenchVector vector_in = generate_random_vector<BenchVector>(colsA); 
 
             // Result buffers
-            vector<double> result_mv(rowsA);
-            vector<double> result_mm(rowsA * colsB);
+            BenchVector result_mv(rowsA);
+            BenchVector result_mm(rowsA * colsB);
 
             // --- Benchmark Matrix-Vector (Row Major) ---
             cout << "  Benchmarking multiply_mv_row_major..." << flush;
             auto func_mv_row = [&]() {
                 multiply_mv_row_major(matrixA.data(), rowsA, colsA, vector_in.data(), result_mv.data());
             };
-            auto timing_mv_row = time_function_ms(func_mv_row, num_runs);
-            results.push_back({"multiply_mv_row_major", rowsA, colsA, 1, timing_mv_row.first, timing_mv_row.second, num_runs});
+            bench(results, "multiply_mv_row_major", rowsA, colsA, 1, func_mv_row, session);
             cout << " Done." << endl;
 
              // --- Benchmark Matrix-Vector (Col Major) ---
             cout << "  Benchmarking multiply_mv_col_major..." << flush;
-            vector<double> matrixA_col_major = transpose_matrix(matrixA, rowsA, colsA); 
+            BenchVector matrixA_col_major = transpose_matrix(matrixA, rowsA, colsA); 
             auto func_mv_col = [&]() {
                 multiply_mv_col_major(matrixA_col_major.data(), rowsA, colsA, vector_in.data(), result_mv.data());
             };
-            auto timing_mv_col = time_function_ms(func_mv_col, num_runs);
-            results.push_back({"multiply_mv_col_major", rowsA, colsA, 1, timing_mv_col.first, timing_mv_col.second, num_runs});
+            bench(results, "multiply_mv_col_major", rowsA, colsA, 1, func_mv_col, session);
+            cout << " Done." << endl;
+
+            // --- Benchmark transposes (colsB == 0: no flops) ---
+            cout << "  Benchmarking transpose..." << flush;
+            BenchVector transposed(colsA * rowsA);
+            bench(results, "transpose_naive", rowsA, colsA, 0, [&]() { transpose_naive(matrixA.data(), rowsA, colsA, transposed.data()); }, session);
+            // Same strided walk with both buffers on 2MB pages: fewer dTLB misses
+            HugePageVector<double> huge_src(matrixA.begin(), matrixA.end()), huge_dst(colsA * rowsA);
+            bench(results, "transpose_naive (huge pages)", rowsA, colsA, 0, [&]() { transpose_naive(huge_src.data(), rowsA, colsA, huge_dst.data()); }, session);
+            bench(results, "transpose", rowsA, colsA, 0, [&]() { transpose(matrixA.data(), rowsA, colsA, colsA, transposed.data(), rowsA); }, session);
+            if (rowsA == colsA) {
+                bench(results, "transpose_in_place", rowsA, colsA, 0, [&]() { transpose_in_place(matrixA.data(), rowsA, colsA); }, session);
+            }
             cout << " Done." << endl;
 
             // --- Benchmark Matrix-Matrix (Naive) ---
@@ -326,20 +1184,18 @@ int main(int argc, char* argv[]) {
             auto func_mm_naive = [&]() {
                 multiply_mm_naive(matrixA.data(), rowsA, colsA, matrixB.data(), rowsB, colsB, result_mm.data());
             };
-            auto timing_mm_naive = time_function_ms(func_mm_naive, num_runs);
-            results.push_back({"multiply_mm_naive", rowsA, colsA, colsB, timing_mm_naive.first, timing_mm_naive.second, num_runs});
+            bench(results, "multiply_mm_naive", rowsA, colsA, colsB, func_mm_naive, session);
             cout << " Done." << endl;
 
             // --- Benchmark Matrix-Matrix (Transposed B) ---
             cout << "  Benchmarking multiply_mm_transposed_b..." << flush;
-            vector<double> matrixB_T = transpose_matrix(matrixB, rowsB, colsB);
+            BenchVector matrixB_T = transpose_matrix(matrixB, rowsB, colsB);
             int rowsB_T = colsB;
             int colsB_T = rowsB; 
             auto func_mm_transposed = [&]() {
                 multiply_mm_transposed_b(matrixA.data(), rowsA, colsA, matrixB_T.data(), rowsB_T, colsB_T, result_mm.data());
             };
-            auto timing_mm_transposed = time_function_ms(func_mm_transposed, num_runs);
-            results.push_back({"multiply_mm_transposed_b", rowsA, colsA, colsB, timing_mm_transposed.first, timing_mm_transposed.second, num_runs});
+            bench(results, "multiply_mm_transposed_b", rowsA, colsA, colsB, func_mm_transposed, session);
             cout << " Done." << endl;
 
             // --- Benchmark Matrix-Matrix (Transposed B)-no inline ---
@@ -347,8 +1203,7 @@ int main(int argc, char* argv[]) {
             auto func_mm_transposed_noinline = [&]() {
                 multiply_mm_transposed_b_noinline(matrixA.data(), rowsA, colsA, matrixB_T.data(), rowsB_T, colsB_T, result_mm.data());
                 };
-            auto timing_mm_transposed_noinline = time_function_ms(func_mm_transposed_noinline, num_runs);
-            results.push_back({ "multiply_mm_t_b_noinline", rowsA, colsA, colsB, timing_mm_transposed_noinline.first, timing_mm_transposed_noinline.second, num_runs });
+            bench(results, "multiply_mm_t_b_noinline", rowsA, colsA, colsB, func_mm_transposed_noinline, session);
             cout << " Done." << endl;
 
             // --- Benchmark Matrix-Matrix (Optimized) ---
@@ -356,8 +1211,7 @@ int main(int argc, char* argv[]) {
             auto func_mm_optimized = [&]() {
                 multiply_mm_optimized(matrixA.data(), rowsA, colsA, matrixB.data(), rowsB, colsB, result_mm.data());
             };
-            auto timing_mm_optimized = time_function_ms(func_mm_optimized, num_runs);
-            results.push_back({"multiply_mm_optimized", rowsA, colsA, colsB, timing_mm_optimized.first, timing_mm_optimized.second, num_runs});
+            bench(results, "multiply_mm_optimized", rowsA, colsA, colsB, func_mm_optimized, session);
             cout << " Done." << endl;
 
             // --- Benchmark Matrix-Matrix (Optimized)- no inline---
@@ -365,8 +1219,41 @@ int main(int argc, char* argv[]) {
             auto func_mm_optimized_noinline = [&]() {
                 multiply_mm_optimized_noinline(matrixA.data(), rowsA, colsA, matrixB.data(), rowsB, colsB, result_mm.data());
                 };
-            auto timing_mm_optimized_noinline = time_function_ms(func_mm_optimized_noinline, num_runs);
-            results.push_back({ "multiply_mm_opti_noinline", rowsA, colsA, colsB, timing_mm_optimized_noinline.first, timing_mm_optimized_noinline.second, num_runs });
+            bench(results, "multiply_mm_opti_noinline", rowsA, colsA, colsB, func_mm_optimized_noinline, session);
+            cout << " Done." << endl;
+
+            // --- Benchmark Matrix-Matrix (Packed SIMD micro-kernel) ---
+            cout << "  Benchmarking multiply_mm_packed..." << flush;
+            auto func_mm_packed = [&]() {
+                multiply_mm_packed(matrixA.data(), rowsA, colsA, matrixB.data(), rowsB, colsB, result_mm.data());
+            };
+            bench(results, "multiply_mm_packed", rowsA, colsA, colsB, func_mm_packed, session);
+            cout << " Done." << endl;
+
+            // --- Benchmark Matrix-Matrix (Packed, Matrix type with padded rows) ---
+            cout << "  Benchmarking multiply_mm_packed on Matrix..." << flush;
+            Matrix<double> matA(rowsA, colsA), matB(rowsB, colsB), matC(rowsA, colsB);
+            for (int i = 0; i < rowsA; ++i) std::copy_n(matrixA.data() + i * colsA, colsA, matA.view().line(i));
+            for (int i = 0; i < rowsB; ++i) std::copy_n(matrixB.data() + i * colsB, colsB, matB.view().line(i));
+            auto func_mm_packed_matrix = [&]() {
+                multiply_mm_packed(matA, matB, matC);
+            };
+            bench(results, "multiply_mm_packed (Matrix)", rowsA, colsA, colsB, func_mm_packed_matrix, session);
+            cout << " Done." << endl;
+
+            // --- Benchmark single and mixed precision on the same data ---
+            cout << "  Benchmarking float / mixed-precision kernels..." << flush;
+            Matrix<float> fA(rowsA, colsA), fB(rowsB, colsB), fC(rowsA, colsB);
+            vector<float> fx(colsA), fy(rowsA);
+            for (int i = 0; i < rowsA; ++i) for (int j = 0; j < colsA; ++j) fA(i, j) = static_cast<float>(matA(i, j));
+            for (int i = 0; i < rowsB; ++i) for (int j = 0; j < colsB; ++j) fB(i, j) = static_cast<float>(matB(i, j));
+            for (int i = 0; i < colsA; ++i) fx[i] = static_cast<float>(vector_in[i]);
+
+            bench(results, "gemv_row_major<float>", rowsA, colsA, 1, [&]() { gemv_row_major<float>(fA, fx.data(), fy.data()); }, session);
+            bench(results, "gemv_row_major<float,double>", rowsA, colsA, 1, [&]() { gemv_row_major<float, double>(fA, fx.data(), fy.data()); }, session);
+            bench(results, "gemm_tiled<float>", rowsA, colsA, colsB, [&]() { gemm_tiled<float>(fA, fB, fC); }, session);
+            bench(results, "gemm_packed<float>", rowsA, colsA, colsB, [&]() { gemm_packed<float>(fA, fB, fC); }, session);
+            bench(results, "gemm_packed<float,double>", rowsA, colsA, colsB, [&]() { gemm_packed<float, double>(fA, fB, fC); }, session);
             cout << " Done." << endl;
 
         } catch (const std::exception& e) {
@@ -379,28 +1266,63 @@ int main(int argc, char* argv[]) {
 
     string align_str = align ? "memory-aligned:":"non-memory-aligned:";
 
-    cout << "\n\n--- Benchmark Results (" <<align_str<< " " << num_runs << " runs per test) ---\n";
-    cout << left << setw(28) << "Function"
+    GemmBlocking blk = gemm_default_blocking();
+    cout << "\n\n--- Benchmark Results (" <<align_str<< " adaptive runs per test) ---\n";
+    const TileConfig& tiles = tile_config();
+    cout << "Optimized GEMM tiles: " << tiles.block_i << "x" << tiles.block_j << "x" << tiles.block_k
+         << (tiles.order == TileLoopOrder::IKJ ? " (ikj)" : " (kij)") << "\n";
+    cout << "Packed GEMM kernel: " << gemm_kernel_name()
+         << " (mc=" << blk.mc << ", kc=" << blk.kc << ", nc=" << blk.nc << ")\n";
+    cout << left << setw(30) << "Function"
               << setw(8) << "RowsA"
               << setw(8) << "ColsA"
               << setw(8) << "ColsB"
               << right << setw(15) << "Avg Time (ms)"
-              << setw(15) << "Std Dev (ms)"
+              << setw(15) << "Median (ms)"
+              << setw(12) << "MAD (ms)"
+              << setw(7) << "Runs"
+              << setw(12) << "GFLOP/s"
               << endl;
-    cout << string(81, '-') << endl; 
+    cout << string(115, '-') << endl; 
 
     cout << std::fixed << std::setprecision(4); 
 
     for (const auto& res : results) {
-        cout << left << setw(28) << res.name
+        // 2 flops (mul + add) per inner-product term; colsB == 1 for the matrix-vector
+        // rows and 0 for the transposes
+        double flops = 2.0 * res.rowsA * res.colsA * res.colsB;
+        double gflops = res.median_ms > 0.0 ? flops / (res.median_ms * 1e6) : 0.0;
+        cout << left << setw(30) << res.name
                   << setw(8) << res.rowsA
                   << setw(8) << res.colsA
                   << setw(8) << res.colsB
                   << right << std::setw(15) << res.avg_time_ms
-                  << setw(15) << res.std_dev_ms
+                  << setw(15) << res.median_ms
+                  << setw(12) << res.mad_ms
+                  << setw(7) << res.runs
+                  << setw(12) << gflops
                   << endl;
     }
-    cout << string(81, '-') << endl;
+    cout << string(115, '-') << endl;
+
+    if (!csv_path.empty()) {
+        std::ofstream csv(csv_path);
+        write_results_csv(csv, results);
+        cout << "Results written to " << csv_path << endl;
+    }
+    if (!json_path.empty()) {
+        std::ofstream json(json_path);
+        write_results_json(json, results);
+        cout << "Results written to " << json_path << endl;
+    }
+
+    print_counter_table(session);
+
+    run_scaling_benchmarks(options);
+
+    run_batched_benchmarks(options);
+
+    run_sparse_benchmarks(options);
 
     return 0;
 }
@@ -0,0 +1,122 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include "alignment.h"
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+enum class Layout { RowMajor, ColMajor };
+
+// Non-owning window onto a strided matrix. ld ("leading dimension") is the
+// distance in elements between the starts of consecutive rows (RowMajor) or
+// columns (ColMajor), so a sub-block of a bigger matrix is just a new
+// pointer + extents with the parent's ld -- no copy.
+template <typename T, Layout L = Layout::RowMajor>
+class MatrixView {
+public:
+    using value_type = T;
+    static constexpr Layout layout = L;
+
+    MatrixView() = default;
+
+    MatrixView(T* data, int rows, int cols, int ld)
+        : data_(data), rows_(rows), cols_(cols), ld_(ld) {
+        if (rows < 0 || cols < 0 || ld < (L == Layout::RowMajor ? cols : rows)) {
+            throw std::invalid_argument("Invalid matrix view dimensions.");
+        }
+    }
+
+    // Dense view: ld equals the inner extent
+    MatrixView(T* data, int rows, int cols)
+        : MatrixView(data, rows, cols, L == Layout::RowMajor ? cols : rows) {}
+
+    // MatrixView<double> -> MatrixView<const double>
+    template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+    MatrixView(const MatrixView<U, L>& other)
+        : data_(other.data()), rows_(other.rows()), cols_(other.cols()), ld_(other.ld()) {}
+
+    T* data() const { return data_; }
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int ld() const { return ld_; }
+
+    T& operator()(int i, int j) const {
+        return L == Layout::RowMajor ? data_[static_cast<std::size_t>(i) * ld_ + j]
+                                     : data_[static_cast<std::size_t>(j) * ld_ + i];
+    }
+
+    // Pointer to the start of row i (RowMajor) or column i (ColMajor)
+    T* line(int i) const { return data_ + static_cast<std::size_t>(i) * ld_; }
+
+    MatrixView block(int row, int col, int rows, int cols) const {
+        if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ || col + cols > cols_) {
+            throw std::out_of_range("Matrix block out of range.");
+        }
+        return MatrixView(&(*this)(row, col), rows, cols, ld_);
+    }
+
+private:
+    T* data_ = nullptr;
+    int rows_ = 0;
+    int cols_ = 0;
+    int ld_ = 0;
+};
+
+// Owning matrix on 64-byte aligned storage. The leading dimension is padded
+// to a whole number of cache lines, so every row (or column) starts on a
+// 64-byte boundary and SIMD kernels can use aligned loads on each of them.
+template <typename T, Layout L = Layout::RowMajor>
+class Matrix {
+public:
+    static constexpr std::size_t alignment = 64;
+    using value_type = T;
+    using view_type = MatrixView<T, L>;
+    using const_view_type = MatrixView<const T, L>;
+
+    Matrix() = default;
+
+    Matrix(int rows, int cols)
+        : Matrix(rows, cols, padded_ld(L == Layout::RowMajor ? cols : rows)) {}
+
+    Matrix(int rows, int cols, int ld)
+        : rows_(rows), cols_(cols), ld_(ld) {
+        if (rows < 0 || cols < 0 || ld < (L == Layout::RowMajor ? cols : rows)) {
+            throw std::invalid_argument("Invalid matrix dimensions.");
+        }
+        storage_.resize(static_cast<std::size_t>(ld) * (L == Layout::RowMajor ? rows : cols));
+    }
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int ld() const { return ld_; }
+    T* data() { return storage_.data(); }
+    const T* data() const { return storage_.data(); }
+
+    T& operator()(int i, int j) { return view()(i, j); }
+    const T& operator()(int i, int j) const { return view()(i, j); }
+
+    view_type view() { return view_type(storage_.data(), rows_, cols_, ld_); }
+    const_view_type view() const { return const_view_type(storage_.data(), rows_, cols_, ld_); }
+
+    view_type block(int row, int col, int rows, int cols) { return view().block(row, col, rows, cols); }
+    const_view_type block(int row, int col, int rows, int cols) const { return view().block(row, col, rows, cols); }
+
+    operator view_type() { return view(); }
+    operator const_view_type() const { return view(); }
+
+    // Smallest ld >= extent that keeps each row/column cache-line aligned
+    static int padded_ld(int extent) {
+        constexpr int per_line = static_cast<int>(alignment / sizeof(T)) > 0 ? static_cast<int>(alignment / sizeof(T)) : 1;
+        return (extent + per_line - 1) / per_line * per_line;
+    }
+
+private:
+    std::vector<T, AlignedAllocator<T, alignment>> storage_;
+    int rows_ = 0;
+    int cols_ = 0;
+    int ld_ = 0;
+};
+
+#endif
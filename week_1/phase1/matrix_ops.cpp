@@ -3,6 +3,7 @@
 #include <vector>
 #include <stdexcept>
 #include <cassert>
+#include <algorithm>
 
 inline void check_null(const void* ptr, const char* name) {
     if (!ptr) {
@@ -121,8 +122,28 @@ void multiply_mm_transposed_b_noinline(const double* matrixA, int rowsA, int col
 
 }
 
+namespace {
+TileConfig active_tile_config;
+}
+
+const TileConfig& tile_config() {
+    return active_tile_config;
+}
+
+void set_tile_config(const TileConfig& config) {
+    if (config.block_i <= 0 || config.block_j <= 0 || config.block_k <= 0) {
+        throw std::invalid_argument("Tile block sizes must be positive.");
+    }
+    active_tile_config = config;
+}
+
 // Implemented by the team collaboratively
 void multiply_mm_optimized(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result)
+{
+    multiply_mm_tiled(matrixA, rowsA, colsA, matrixB, rowsB, colsB, result, active_tile_config);
+}
+
+void multiply_mm_tiled(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result, const TileConfig& config)
 {
     check_null(matrixA, "matrixA");
     check_null(matrixB, "matrixB");
@@ -130,6 +151,19 @@ void multiply_mm_optimized(const double* matrixA, int rowsA, int colsA, const do
     if (colsA != rowsB) {
         throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
     }
+    multiply_mm_tiled(ConstMatrixView(matrixA, rowsA, colsA), ConstMatrixView(matrixB, rowsB, colsB),
+                      MutableMatrixView(result, rowsA, colsB), config);
+}
+
+// Implemented by the team collaboratively
+void multiply_mm_optimized_noinline(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result)
+{
+    check_null_slow(matrixA, "matrixA");
+    check_null_slow(matrixB, "matrixB");
+    check_null_slow(result, "result");
+    if (colsA != rowsB) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
+    }
 
     std::fill_n(result, rowsA * colsB, 0.0);
 
@@ -156,34 +190,134 @@ void multiply_mm_optimized(const double* matrixA, int rowsA, int colsA, const do
     }
 }
 
+namespace {
 
-// Implemented by the team collaboratively
-void multiply_mm_optimized_noinline(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result)
-{
-    check_null_slow(matrixA, "matrixA");
-    check_null_slow(matrixB, "matrixB");
-    check_null_slow(result, "result");
-    if (colsA != rowsB) {
+void check_mm_views(ConstMatrixView A, ConstMatrixView B, MutableMatrixView C) {
+    check_null(A.data(), "matrixA");
+    check_null(B.data(), "matrixB");
+    check_null(C.data(), "result");
+    if (A.cols() != B.rows() || C.rows() != A.rows() || C.cols() != B.cols()) {
         throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
     }
+}
 
-    std::fill_n(result, rowsA * colsB, 0.0);
+void zero_view(MutableMatrixView C) {
+    for (int i = 0; i < C.rows(); ++i) {
+        std::fill_n(C.line(i), C.cols(), 0.0);
+    }
+}
 
-    const int blockSize = 64;
+} // namespace
+
+void multiply_mv_row_major(ConstMatrixView matrix, const double* vector, double* result) {
+    check_null(matrix.data(), "matrix");
+    check_null(vector, "vector");
+    check_null(result, "result");
+    for (int i = 0; i < matrix.rows(); ++i) {
+        const double* row = matrix.line(i);
+        double sum = 0.0;
+        for (int k = 0; k < matrix.cols(); ++k) {
+            sum += row[k] * vector[k];
+        }
+        result[i] = sum;
+    }
+}
+
+void multiply_mv_col_major(ConstColMajorView matrix, const double* vector, double* result) {
+    check_null(matrix.data(), "matrix");
+    check_null(vector, "vector");
+    check_null(result, "result");
+    std::fill_n(result, matrix.rows(), 0.0);
+    for (int i = 0; i < matrix.cols(); ++i) {
+        const double* column = matrix.line(i);
+        const double v = vector[i];
+        for (int j = 0; j < matrix.rows(); ++j) {
+            result[j] += column[j] * v;
+        }
+    }
+}
+
+void multiply_mm_naive(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result) {
+    check_mm_views(matrixA, matrixB, result);
+    for (int i = 0; i < result.rows(); ++i) {
+        const double* a_row = matrixA.line(i);
+        double* c_row = result.line(i);
+        for (int j = 0; j < result.cols(); ++j) {
+            double sum = 0.0;
+            for (int k = 0; k < matrixA.cols(); ++k) {
+                sum += a_row[k] * matrixB(k, j);
+            }
+            c_row[j] = sum;
+        }
+    }
+}
+
+void multiply_mm_transposed_b(ConstMatrixView matrixA, ConstMatrixView matrixB_transposed, MutableMatrixView result) {
+    check_null(matrixA.data(), "matrixA");
+    check_null(matrixB_transposed.data(), "matrixB_transposed");
+    check_null(result.data(), "result");
+    if (matrixA.cols() != matrixB_transposed.cols() || result.rows() != matrixA.rows() || result.cols() != matrixB_transposed.rows()) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication (A * B^T).");
+    }
+    for (int i = 0; i < result.rows(); ++i) {
+        const double* a_row = matrixA.line(i);
+        double* c_row = result.line(i);
+        for (int j = 0; j < result.cols(); ++j) {
+            const double* bt_row = matrixB_transposed.line(j);
+            double sum = 0.0;
+            for (int k = 0; k < matrixA.cols(); ++k) {
+                sum += a_row[k] * bt_row[k];
+            }
+            c_row[j] = sum;
+        }
+    }
+}
+
+void multiply_mm_optimized(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result) {
+    multiply_mm_tiled(matrixA, matrixB, result, active_tile_config);
+}
+
+void multiply_mm_tiled(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result, const TileConfig& config) {
+    check_mm_views(matrixA, matrixB, result);
+    zero_view(result);
+
+    const int rowsA = matrixA.rows();
+    const int colsA = matrixA.cols();
+    const int colsB = matrixB.cols();
+    const int bi = config.block_i;
+    const int bj = config.block_j;
+    const int bk = config.block_k;
     // Iterate over blocks
-    for (int i0 = 0; i0 < rowsA; i0 += blockSize) {
-        for (int j0 = 0; j0 < colsB; j0 += blockSize) {
-            for (int k0 = 0; k0 < colsA; k0 += blockSize) {
-                int i_max = std::min(i0 + blockSize, rowsA);
-                int j_max = std::min(j0 + blockSize, colsB);
-                int k_max = std::min(k0 + blockSize, colsA);
+    for (int i0 = 0; i0 < rowsA; i0 += bi) {
+        for (int j0 = 0; j0 < colsB; j0 += bj) {
+            for (int k0 = 0; k0 < colsA; k0 += bk) {
+                int i_max = std::min(i0 + bi, rowsA);
+                int j_max = std::min(j0 + bj, colsB);
+                int k_max = std::min(k0 + bk, colsA);
 
-                // Perform multiplication for the current blocks using i, k, j loop order
-                for (int i = i0; i < i_max; ++i) {
+                if (config.order == TileLoopOrder::IKJ) {
+                    // Perform multiplication for the current blocks using i, k, j loop order
+                    for (int i = i0; i < i_max; ++i) {
+                        const double* a_row = matrixA.line(i);
+                        double* c_row = result.line(i);
+                        for (int k = k0; k < k_max; ++k) {
+                            const double a_ik = a_row[k];
+                            const double* b_row = matrixB.line(k);
+                            for (int j = j0; j < j_max; ++j) {
+                                c_row[j] += a_ik * b_row[j];
+                            }
+                        }
+                    }
+                } else {
+                    // k, i, j: one row of the B block is reused across every row of the C block
                     for (int k = k0; k < k_max; ++k) {
-                        const double a_ik = matrixA[i * colsA + k];
-                        for (int j = j0; j < j_max; ++j) {
-                            result[i * colsB + j] += a_ik * matrixB[k * colsB + j];
+                        const double* b_row = matrixB.line(k);
+                        for (int i = i0; i < i_max; ++i) {
+                            const double a_ik = matrixA(i, k);
+                            double* c_row = result.line(i);
+                            for (int j = j0; j < j_max; ++j) {
+                                c_row[j] += a_ik * b_row[j];
+                            }
                         }
                     }
                 }
@@ -191,3 +325,116 @@ void multiply_mm_optimized_noinline(const double* matrixA, int rowsA, int colsA,
         }
     }
 }
+
+template <typename T, typename Acc>
+void gemv_row_major(MatrixView<const T> matrix, const T* vector, T* result) {
+    check_null(matrix.data(), "matrix");
+    check_null(vector, "vector");
+    check_null(result, "result");
+    for (int i = 0; i < matrix.rows(); ++i) {
+        const T* row = matrix.line(i);
+        Acc sum = 0;
+        for (int k = 0; k < matrix.cols(); ++k) {
+            sum += static_cast<Acc>(row[k]) * static_cast<Acc>(vector[k]);
+        }
+        result[i] = static_cast<T>(sum);
+    }
+}
+
+template <typename T, typename Acc>
+void gemv_col_major(MatrixView<const T, Layout::ColMajor> matrix, const T* vector, T* result) {
+    check_null(matrix.data(), "matrix");
+    check_null(vector, "vector");
+    check_null(result, "result");
+    // The running sums live in Acc until every column has been added
+    thread_local std::vector<Acc> acc;
+    acc.assign(matrix.rows(), Acc(0));
+    for (int i = 0; i < matrix.cols(); ++i) {
+        const T* column = matrix.line(i);
+        const Acc v = static_cast<Acc>(vector[i]);
+        for (int j = 0; j < matrix.rows(); ++j) {
+            acc[j] += static_cast<Acc>(column[j]) * v;
+        }
+    }
+    for (int j = 0; j < matrix.rows(); ++j) {
+        result[j] = static_cast<T>(acc[j]);
+    }
+}
+
+template <typename T, typename Acc>
+void gemm_tiled(MatrixView<const T> matrixA, MatrixView<const T> matrixB, MatrixView<T> result, const TileConfig& config) {
+    check_null(matrixA.data(), "matrixA");
+    check_null(matrixB.data(), "matrixB");
+    check_null(result.data(), "result");
+    if (matrixA.cols() != matrixB.rows() || result.rows() != matrixA.rows() || result.cols() != matrixB.cols()) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
+    }
+
+    const int rowsA = matrixA.rows();
+    const int colsA = matrixA.cols();
+    const int colsB = matrixB.cols();
+    const int bi = config.block_i;
+    const int bj = config.block_j;
+    const int bk = config.block_k;
+
+    // One bi x bj accumulator tile, reused for every (i0, j0) block
+    thread_local std::vector<Acc> tile;
+    tile.resize(static_cast<size_t>(bi) * bj);
+
+    for (int i0 = 0; i0 < rowsA; i0 += bi) {
+        for (int j0 = 0; j0 < colsB; j0 += bj) {
+            int i_max = std::min(i0 + bi, rowsA);
+            int j_max = std::min(j0 + bj, colsB);
+            int width = j_max - j0;
+            std::fill(tile.begin(), tile.end(), Acc(0));
+
+            for (int k0 = 0; k0 < colsA; k0 += bk) {
+                int k_max = std::min(k0 + bk, colsA);
+                if (config.order == TileLoopOrder::IKJ) {
+                    for (int i = i0; i < i_max; ++i) {
+                        const T* a_row = matrixA.line(i);
+                        Acc* t_row = tile.data() + (i - i0) * width;
+                        for (int k = k0; k < k_max; ++k) {
+                            const Acc a_ik = static_cast<Acc>(a_row[k]);
+                            const T* b_row = matrixB.line(k) + j0;
+                            for (int j = 0; j < width; ++j) {
+                                t_row[j] += a_ik * static_cast<Acc>(b_row[j]);
+                            }
+                        }
+                    }
+                } else {
+                    for (int k = k0; k < k_max; ++k) {
+                        const T* b_row = matrixB.line(k) + j0;
+                        for (int i = i0; i < i_max; ++i) {
+                            const Acc a_ik = static_cast<Acc>(matrixA(i, k));
+                            Acc* t_row = tile.data() + (i - i0) * width;
+                            for (int j = 0; j < width; ++j) {
+                                t_row[j] += a_ik * static_cast<Acc>(b_row[j]);
+                            }
+                        }
+                    }
+                }
+            }
+
+            for (int i = i0; i < i_max; ++i) {
+                T* c_row = result.line(i) + j0;
+                const Acc* t_row = tile.data() + (i - i0) * width;
+                for (int j = 0; j < width; ++j) {
+                    c_row[j] = static_cast<T>(t_row[j]);
+                }
+            }
+        }
+    }
+}
+
+template void gemv_row_major<double, double>(MatrixView<const double>, const double*, double*);
+template void gemv_row_major<float, float>(MatrixView<const float>, const float*, float*);
+template void gemv_row_major<float, double>(MatrixView<const float>, const float*, float*);
+
+template void gemv_col_major<double, double>(MatrixView<const double, Layout::ColMajor>, const double*, double*);
+template void gemv_col_major<float, float>(MatrixView<const float, Layout::ColMajor>, const float*, float*);
+template void gemv_col_major<float, double>(MatrixView<const float, Layout::ColMajor>, const float*, float*);
+
+template void gemm_tiled<double, double>(MatrixView<const double>, MatrixView<const double>, MatrixView<double>, const TileConfig&);
+template void gemm_tiled<float, float>(MatrixView<const float>, MatrixView<const float>, MatrixView<float>, const TileConfig&);
+template void gemm_tiled<float, double>(MatrixView<const float>, MatrixView<const float>, MatrixView<float>, const TileConfig&);
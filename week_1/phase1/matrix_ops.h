@@ -2,6 +2,27 @@
 #define MATRIX_OPS_H
 
 #include <stdexcept>
+#include "matrix.h"
+
+using ConstMatrixView = MatrixView<const double, Layout::RowMajor>;
+using MutableMatrixView = MatrixView<double, Layout::RowMajor>;
+using ConstColMajorView = MatrixView<const double, Layout::ColMajor>;
+
+// Cache-tiling parameters for multiply_mm_optimized. Each block size is the
+// extent of one loop level; order picks the loop nest inside a block (j is
+// innermost in both so B and C are always walked contiguously).
+enum class TileLoopOrder { IKJ, KIJ };
+
+struct TileConfig {
+    int block_i = 64;
+    int block_j = 64;
+    int block_k = 64;
+    TileLoopOrder order = TileLoopOrder::IKJ;
+};
+
+// Configuration used by multiply_mm_optimized; see autotune.h to tune and persist it
+const TileConfig& tile_config();
+void set_tile_config(const TileConfig& config);
 
 void multiply_mv_row_major(const double* matrix, int rows, int cols, const double* vector, double* result);
 
@@ -15,10 +36,52 @@ void multiply_mm_transposed_b_noinline(const double* matrixA, int rowsA, int col
 
 void multiply_mm_optimized(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result /*, potentially other params like blockSize*/);
 
+void multiply_mm_tiled(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result, const TileConfig& config);
+
 
 void multiply_mm_optimized_noinline(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result /*, potentially other params like blockSize*/);
 
 void multiply_mm_optimized(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result /*, potentially other params like blockSize*/);
 
+// Strided overloads: operands may be a Matrix or any sub-block view of one.
+// Only the elements inside the result view are written.
+void multiply_mv_row_major(ConstMatrixView matrix, const double* vector, double* result);
+
+void multiply_mv_col_major(ConstColMajorView matrix, const double* vector, double* result);
+
+void multiply_mm_naive(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result);
+
+void multiply_mm_transposed_b(ConstMatrixView matrixA, ConstMatrixView matrixB_transposed, MutableMatrixView result);
+
+void multiply_mm_optimized(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result);
+
+void multiply_mm_tiled(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result, const TileConfig& config);
+
+// dst (cols x rows) = src^T (rows x cols). Recursively halves the longer side
+// until a block fits in L1, then transposes 4x4 register tiles (AVX2) or
+// scalar elements. Defined in transpose.cpp.
+void transpose(const double* src, int rows, int cols, int ld_src, double* dst, int ld_dst);
+
+void transpose(ConstMatrixView src, MutableMatrixView dst);
+
+// Square n x n transpose without a second matrix; tiles are swapped pairwise
+// across the diagonal through a small stack buffer
+void transpose_in_place(double* matrix, int n, int ld);
+
+void transpose_in_place(MutableMatrixView matrix);
+
+// Precision-generic kernels: T is the storage type, Acc the accumulator type.
+// Instantiated for <double>, <float> and the mixed-precision <float, double>.
+template <typename T, typename Acc = T>
+void gemv_row_major(MatrixView<const T> matrix, const T* vector, T* result);
+
+template <typename T, typename Acc = T>
+void gemv_col_major(MatrixView<const T, Layout::ColMajor> matrix, const T* vector, T* result);
+
+// Same tiling as multiply_mm_tiled, but each C tile is accumulated in Acc across
+// the whole k range and rounded to T once
+template <typename T, typename Acc = T>
+void gemm_tiled(MatrixView<const T> matrixA, MatrixView<const T> matrixB, MatrixView<T> result, const TileConfig& config = tile_config());
+
 
 #endif
@@ -0,0 +1,169 @@
+#include "parallel_ops.h"
+#include "matrix_ops.h"
+#include "gemm.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+inline void check_null(const void* ptr, const char* name) {
+    if (!ptr) {
+        throw std::invalid_argument(std::string(name) + " cannot be null.");
+    }
+}
+
+// Keep chunk boundaries on multiples of `align` so tiled kernels see whole tiles
+int aligned_grain(int grain, int rows, unsigned threads, int align) {
+    if (grain <= 0) {
+        grain = (rows + static_cast<int>(threads) - 1) / static_cast<int>(threads);
+    }
+    return (grain + align - 1) / align * align;
+}
+
+} // namespace
+
+void first_touch_parallel(double* data, int rows, int row_length, ThreadPool& pool, int grain, int tile_rows) {
+    check_null(data, "data");
+    if (tile_rows > 1) {
+        grain = aligned_grain(grain, rows, pool.size(), tile_rows);
+    }
+    pool.parallel_for(0, rows, grain, [&](int lo, int hi) {
+        std::fill_n(data + static_cast<size_t>(lo) * row_length, static_cast<size_t>(hi - lo) * row_length, 0.0);
+    });
+}
+
+void multiply_mv_row_major_parallel(const double* matrix, int rows, int cols, const double* vector, double* result, ThreadPool& pool, int grain) {
+    check_null(matrix, "matrix");
+    check_null(vector, "vector");
+    check_null(result, "result");
+    pool.parallel_for(0, rows, grain, [&](int lo, int hi) {
+        multiply_mv_row_major(matrix + static_cast<size_t>(lo) * cols, hi - lo, cols, vector, result + lo);
+    });
+}
+
+void multiply_mv_col_major_parallel(const double* matrix, int rows, int cols, const double* vector, double* result, ThreadPool& pool, int grain) {
+    check_null(matrix, "matrix");
+    check_null(vector, "vector");
+    check_null(result, "result");
+    // Each thread owns a band of result rows and walks every column over that band
+    pool.parallel_for(0, rows, grain, [&](int lo, int hi) {
+        std::fill(result + lo, result + hi, 0.0);
+        for (int i = 0; i < cols; ++i) {
+            const double* column = matrix + static_cast<size_t>(i) * rows;
+            const double v = vector[i];
+            for (int j = lo; j < hi; ++j) {
+                result[j] += column[j] * v;
+            }
+        }
+    });
+}
+
+void multiply_mm_naive_parallel(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result, ThreadPool& pool, int grain) {
+    check_null(matrixA, "matrixA");
+    check_null(matrixB, "matrixB");
+    check_null(result, "result");
+    if (colsA != rowsB) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
+    }
+    pool.parallel_for(0, rowsA, grain, [&](int lo, int hi) {
+        multiply_mm_naive(matrixA + static_cast<size_t>(lo) * colsA, hi - lo, colsA, matrixB, rowsB, colsB,
+                          result + static_cast<size_t>(lo) * colsB);
+    });
+}
+
+void multiply_mm_transposed_b_parallel(const double* matrixA, int rowsA, int colsA, const double* matrixB_transposed, int rowsB_T, int colsB_T, double* result, ThreadPool& pool, int grain) {
+    check_null(matrixA, "matrixA");
+    check_null(matrixB_transposed, "matrixB_transposed");
+    check_null(result, "result");
+    if (colsA != colsB_T) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication (A * B^T).");
+    }
+    pool.parallel_for(0, rowsA, grain, [&](int lo, int hi) {
+        multiply_mm_transposed_b(matrixA + static_cast<size_t>(lo) * colsA, hi - lo, colsA, matrixB_transposed, rowsB_T, colsB_T,
+                                 result + static_cast<size_t>(lo) * rowsB_T);
+    });
+}
+
+void multiply_mm_optimized_parallel(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result, ThreadPool& pool, int grain) {
+    check_null(matrixA, "matrixA");
+    check_null(matrixB, "matrixB");
+    check_null(result, "result");
+    if (colsA != rowsB) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
+    }
+    // Chunks on block_i boundaries so no thread gets a sliver of a cache block
+    grain = aligned_grain(grain, rowsA, pool.size(), tile_config().block_i);
+    pool.parallel_for(0, rowsA, grain, [&](int lo, int hi) {
+        multiply_mm_optimized(matrixA + static_cast<size_t>(lo) * colsA, hi - lo, colsA, matrixB, rowsB, colsB,
+                              result + static_cast<size_t>(lo) * colsB);
+    });
+}
+
+void multiply_mm_packed_parallel(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result, ThreadPool& pool, int grain) {
+    check_null(matrixA, "matrixA");
+    check_null(matrixB, "matrixB");
+    check_null(result, "result");
+    if (colsA != rowsB) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
+    }
+    // Each thread packs B into its own thread_local buffer; on the row counts we
+    // parallelise (hundreds+) that copy is small next to the multiply itself
+    grain = aligned_grain(grain, rowsA, pool.size(), 6);
+    pool.parallel_for(0, rowsA, grain, [&](int lo, int hi) {
+        multiply_mm_packed(matrixA + static_cast<size_t>(lo) * colsA, hi - lo, colsA, matrixB, rowsB, colsB,
+                           result + static_cast<size_t>(lo) * colsB);
+    });
+}
+
+void multiply_mv_row_major_parallel(ConstMatrixView matrix, const double* vector, double* result, ThreadPool& pool, int grain) {
+    check_null(result, "result");
+    pool.parallel_for(0, matrix.rows(), grain, [&](int lo, int hi) {
+        multiply_mv_row_major(matrix.block(lo, 0, hi - lo, matrix.cols()), vector, result + lo);
+    });
+}
+
+void multiply_mv_col_major_parallel(ConstColMajorView matrix, const double* vector, double* result, ThreadPool& pool, int grain) {
+    check_null(result, "result");
+    pool.parallel_for(0, matrix.rows(), grain, [&](int lo, int hi) {
+        multiply_mv_col_major(matrix.block(lo, 0, hi - lo, matrix.cols()), vector, result + lo);
+    });
+}
+
+void multiply_mm_naive_parallel(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result, ThreadPool& pool, int grain) {
+    if (result.rows() != matrixA.rows()) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
+    }
+    pool.parallel_for(0, matrixA.rows(), grain, [&](int lo, int hi) {
+        multiply_mm_naive(matrixA.block(lo, 0, hi - lo, matrixA.cols()), matrixB, result.block(lo, 0, hi - lo, result.cols()));
+    });
+}
+
+void multiply_mm_transposed_b_parallel(ConstMatrixView matrixA, ConstMatrixView matrixB_transposed, MutableMatrixView result, ThreadPool& pool, int grain) {
+    if (result.rows() != matrixA.rows()) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication (A * B^T).");
+    }
+    pool.parallel_for(0, matrixA.rows(), grain, [&](int lo, int hi) {
+        multiply_mm_transposed_b(matrixA.block(lo, 0, hi - lo, matrixA.cols()), matrixB_transposed, result.block(lo, 0, hi - lo, result.cols()));
+    });
+}
+
+void multiply_mm_optimized_parallel(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result, ThreadPool& pool, int grain) {
+    if (result.rows() != matrixA.rows()) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
+    }
+    grain = aligned_grain(grain, matrixA.rows(), pool.size(), tile_config().block_i);
+    pool.parallel_for(0, matrixA.rows(), grain, [&](int lo, int hi) {
+        multiply_mm_optimized(matrixA.block(lo, 0, hi - lo, matrixA.cols()), matrixB, result.block(lo, 0, hi - lo, result.cols()));
+    });
+}
+
+void multiply_mm_packed_parallel(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result, ThreadPool& pool, int grain) {
+    if (result.rows() != matrixA.rows()) {
+        throw std::invalid_argument("Incompatible dimensions for matrix multiplication.");
+    }
+    grain = aligned_grain(grain, matrixA.rows(), pool.size(), 6);
+    pool.parallel_for(0, matrixA.rows(), grain, [&](int lo, int hi) {
+        multiply_mm_packed(matrixA.block(lo, 0, hi - lo, matrixA.cols()), matrixB, result.block(lo, 0, hi - lo, result.cols()));
+    });
+}
@@ -0,0 +1,43 @@
+#ifndef PARALLEL_OPS_H
+#define PARALLEL_OPS_H
+
+#include "thread_pool.h"
+#include "matrix_ops.h"
+
+// Multithreaded versions of the kernels in matrix_ops.h / gemm.h.
+// Rows of the result are split into grain-sized chunks (grain <= 0: one chunk
+// per thread) and each chunk runs the sequential kernel on its slice, so every
+// thread zero-fills -- and therefore first-touches -- the rows it writes.
+// To keep a fresh (uninitialised) buffer on the computing thread's NUMA node,
+// call first_touch_parallel on it with the same pool and grain before anything
+// else writes to it; tile_rows matches the tiled GEMMs, which round grain up to
+// their tile height (64 rows optimized, 6 packed).
+
+void first_touch_parallel(double* data, int rows, int row_length, ThreadPool& pool, int grain = 0, int tile_rows = 1);
+
+void multiply_mv_row_major_parallel(const double* matrix, int rows, int cols, const double* vector, double* result, ThreadPool& pool, int grain = 0);
+
+void multiply_mv_col_major_parallel(const double* matrix, int rows, int cols, const double* vector, double* result, ThreadPool& pool, int grain = 0);
+
+void multiply_mm_naive_parallel(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result, ThreadPool& pool, int grain = 0);
+
+void multiply_mm_transposed_b_parallel(const double* matrixA, int rowsA, int colsA, const double* matrixB_transposed, int rowsB_T, int colsB_T, double* result, ThreadPool& pool, int grain = 0);
+
+void multiply_mm_optimized_parallel(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result, ThreadPool& pool, int grain = 0);
+
+void multiply_mm_packed_parallel(const double* matrixA, int rowsA, int colsA, const double* matrixB, int rowsB, int colsB, double* result, ThreadPool& pool, int grain = 0);
+
+// Strided overloads: each chunk works on a row block() of the operands
+void multiply_mv_row_major_parallel(ConstMatrixView matrix, const double* vector, double* result, ThreadPool& pool, int grain = 0);
+
+void multiply_mv_col_major_parallel(ConstColMajorView matrix, const double* vector, double* result, ThreadPool& pool, int grain = 0);
+
+void multiply_mm_naive_parallel(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result, ThreadPool& pool, int grain = 0);
+
+void multiply_mm_transposed_b_parallel(ConstMatrixView matrixA, ConstMatrixView matrixB_transposed, MutableMatrixView result, ThreadPool& pool, int grain = 0);
+
+void multiply_mm_optimized_parallel(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result, ThreadPool& pool, int grain = 0);
+
+void multiply_mm_packed_parallel(ConstMatrixView matrixA, ConstMatrixView matrixB, MutableMatrixView result, ThreadPool& pool, int grain = 0);
+
+#endif
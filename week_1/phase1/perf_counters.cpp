@@ -0,0 +1,206 @@
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace {
+
+#ifdef __linux__
+struct EventSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cache_config(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+const EventSpec kSpecs[kPerfEventCount] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+};
+
+// A leader (group_fd < 0) starts disabled and reads as a group:
+// {nr, time_enabled, time_running, value[nr]}, leader first, then members in
+// the order they joined. Members follow their leader's enable/disable.
+int open_event(const EventSpec& spec, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = group_fd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+constexpr int kLeader = static_cast<int>(PerfEvent::Cycles);
+constexpr int kGroupHeaderWords = 3;
+
+// Opens every event, joining cycles' group if full_group (otherwise only
+// instructions joins). An event that cannot join is opened on its own.
+void open_events(std::array<int, kPerfEventCount>& fds, std::array<int, kPerfEventCount>& leaders, bool full_group) {
+    fds.fill(-1);
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        leaders[i] = i;
+    }
+    fds[kLeader] = open_event(kSpecs[kLeader], -1);
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        if (i == kLeader) {
+            continue;
+        }
+        if (fds[kLeader] >= 0 && (full_group || i == static_cast<int>(PerfEvent::Instructions))) {
+            fds[i] = open_event(kSpecs[i], fds[kLeader]);
+            if (fds[i] >= 0) {
+                leaders[i] = kLeader;
+                continue;
+            }
+        }
+        fds[i] = open_event(kSpecs[i], -1);
+    }
+}
+
+void close_events(std::array<int, kPerfEventCount>& fds) {
+    for (int& fd : fds) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+// A group larger than the PMU opens fine but is never scheduled; run it
+// briefly and check that it counted
+bool group_runs(int leader_fd) {
+    ioctl(leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    volatile uint64_t sink = 0;
+    for (int i = 0; i < 100000; ++i) {
+        sink = sink + static_cast<uint64_t>(i);
+    }
+    ioctl(leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    uint64_t data[kGroupHeaderWords + kPerfEventCount] = {};
+    return read(leader_fd, data, sizeof(data)) >= static_cast<ssize_t>(kGroupHeaderWords * sizeof(uint64_t)) && data[2] > 0;
+}
+#endif
+
+} // namespace
+
+const char* perf_event_name(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::Cycles: return "cycles";
+        case PerfEvent::Instructions: return "instructions";
+        case PerfEvent::L1DMisses: return "L1d misses";
+        case PerfEvent::LLCMisses: return "LLC misses";
+        case PerfEvent::BranchMisses: return "branch misses";
+        case PerfEvent::DTLBMisses: return "dTLB misses";
+        default: return "unknown";
+    }
+}
+
+double PerfSample::ipc() const {
+    if (!has(PerfEvent::Cycles) || !has(PerfEvent::Instructions) || get(PerfEvent::Cycles) <= 0.0) {
+        return 0.0;
+    }
+    return get(PerfEvent::Instructions) / get(PerfEvent::Cycles);
+}
+
+double PerfSample::per_op(PerfEvent event, double ops) const {
+    return has(event) && ops > 0.0 ? get(event) / ops : 0.0;
+}
+
+PerfSample PerfSample::scaled(double n) const {
+    PerfSample out = *this;
+    if (n > 0.0) {
+        for (double& v : out.values) {
+            v /= n;
+        }
+    }
+    return out;
+}
+
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        leaders_[i] = i;
+    }
+#ifdef __linux__
+    open_events(fds_, leaders_, true);
+    if (fds_[kLeader] >= 0 && !group_runs(fds_[kLeader])) {
+        close_events(fds_);
+        open_events(fds_, leaders_, false);
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    close_events(fds_);
+#endif
+}
+
+bool PerfCounters::available() const {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PerfCounters::start() {
+#ifdef __linux__
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        if (fds_[i] >= 0 && leaders_[i] == i) {
+            ioctl(fds_[i], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+#endif
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+#ifdef __linux__
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        if (fds_[i] >= 0 && leaders_[i] == i) {
+            ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        if (fds_[i] < 0 || leaders_[i] != i) {
+            continue;
+        }
+        // One read per group; every member is scaled by the group's own
+        // enabled/running ratio, so they share a time window
+        uint64_t data[kGroupHeaderWords + kPerfEventCount] = {};
+        ssize_t got = read(fds_[i], data, sizeof(data));
+        if (got < static_cast<ssize_t>(kGroupHeaderWords * sizeof(uint64_t)) || data[2] == 0 ||
+            data[0] > kPerfEventCount ||
+            got < static_cast<ssize_t>((kGroupHeaderWords + data[0]) * sizeof(uint64_t))) {
+            continue;
+        }
+        const double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        uint64_t slot = 0;
+        for (int j = i; j < kPerfEventCount && slot < data[0]; ++j) {
+            if (fds_[j] >= 0 && leaders_[j] == i) {
+                sample.valid[j] = true;
+                sample.values[j] = static_cast<double>(data[kGroupHeaderWords + slot]) * scale;
+                ++slot;
+            }
+        }
+    }
+#endif
+    return sample;
+}
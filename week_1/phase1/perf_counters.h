@@ -0,0 +1,72 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+// Hardware performance counters around a code region, via perf_event_open.
+// Counts user-space events of the calling thread only. Events are opened as
+// one group led by cycles and read together, so ratios such as IPC come
+// from the same time window even when the PMU is multiplexed. If the PMU
+// cannot hold the whole group, only instructions stays with cycles and the
+// rest are counted on their own. An event the PMU lacks (say dTLB misses)
+// is simply missing; in containers or on non-Linux systems where nothing
+// can be opened, available() is false and every sample comes back empty.
+
+#include <array>
+#include <cstdint>
+
+enum class PerfEvent {
+    Cycles,
+    Instructions,
+    L1DMisses,
+    LLCMisses,
+    BranchMisses,
+    DTLBMisses,
+    Count
+};
+
+constexpr int kPerfEventCount = static_cast<int>(PerfEvent::Count);
+
+const char* perf_event_name(PerfEvent event);
+
+struct PerfSample {
+    std::array<bool, kPerfEventCount> valid{};
+    std::array<double, kPerfEventCount> values{}; // scaled for multiplexing
+
+    bool has(PerfEvent event) const { return valid[static_cast<int>(event)]; }
+    double get(PerfEvent event) const { return values[static_cast<int>(event)]; }
+
+    // Instructions per cycle, or 0 if either counter is missing
+    double ipc() const;
+    // event count / ops, or 0 if the counter is missing
+    double per_op(PerfEvent event, double ops) const;
+    // Divides every count by n (e.g. per call when a region ran n iterations)
+    PerfSample scaled(double n) const;
+};
+
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const;
+    bool has(PerfEvent event) const { return fds_[static_cast<int>(event)] >= 0; }
+
+    void start();
+    PerfSample stop();
+
+    template <typename F>
+    PerfSample measure(F&& func, int iterations = 1) {
+        start();
+        for (int i = 0; i < iterations; ++i) {
+            func();
+        }
+        return stop().scaled(iterations);
+    }
+
+private:
+    std::array<int, kPerfEventCount> fds_;
+    std::array<int, kPerfEventCount> leaders_; // index of each event's group leader
+};
+
+#endif
@@ -0,0 +1,253 @@
+#include "sparse.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr int K = BsrMatrix::kBlock;
+
+inline void check_null(const void* ptr, const char* name) {
+    if (!ptr) {
+        throw std::invalid_argument(std::string(name) + " cannot be null.");
+    }
+}
+
+void check_spmm_args(const double* B, int colsB, const double* C) {
+    check_null(B, "matrixB");
+    check_null(C, "result");
+    if (colsB <= 0) {
+        throw std::invalid_argument("colsB must be positive.");
+    }
+}
+
+// --- Row-range kernels shared by the sequential and parallel entry points ---
+
+void csr_spmv_rows(const CsrMatrix& A, const double* x, double* y, int lo, int hi) {
+    const int* row_ptr = A.row_ptr.data();
+    const int* col_idx = A.col_idx.data();
+    const double* values = A.values.data();
+    for (int i = lo; i < hi; ++i) {
+        double sum = 0.0;
+        for (int e = row_ptr[i]; e < row_ptr[i + 1]; ++e) {
+            sum += values[e] * x[col_idx[e]];
+        }
+        y[i] = sum;
+    }
+}
+
+void csr_spmm_rows(const CsrMatrix& A, const double* B, int colsB, double* C, int lo, int hi) {
+    for (int i = lo; i < hi; ++i) {
+        double* c = C + static_cast<std::size_t>(i) * colsB;
+        std::fill_n(c, colsB, 0.0);
+        for (int e = A.row_ptr[i]; e < A.row_ptr[i + 1]; ++e) {
+            const double a = A.values[e];
+            const double* b = B + static_cast<std::size_t>(A.col_idx[e]) * colsB;
+            for (int j = 0; j < colsB; ++j) {
+                c[j] += a * b[j];
+            }
+        }
+    }
+}
+
+void bsr_spmv_rows(const BsrMatrix& A, const double* x, double* y, int lo, int hi) {
+    for (int br = lo; br < hi; ++br) {
+        double acc[K] = {};
+        for (int b = A.row_ptr[br]; b < A.row_ptr[br + 1]; ++b) {
+            const double* blk = A.values.data() + static_cast<std::size_t>(b) * K * K;
+            const int c0 = A.col_idx[b] * K;
+            // Padded edge blocks read zeros instead of past the end of x
+            double xb[K] = {};
+            std::copy_n(x + c0, std::min(K, A.cols - c0), xb);
+            for (int r = 0; r < K; ++r) {
+                for (int c = 0; c < K; ++c) {
+                    acc[r] += blk[r * K + c] * xb[c];
+                }
+            }
+        }
+        const int r0 = br * K;
+        std::copy_n(acc, std::min(K, A.rows - r0), y + r0);
+    }
+}
+
+void bsr_spmm_rows(const BsrMatrix& A, const double* B, int colsB, double* C, int lo, int hi) {
+    for (int br = lo; br < hi; ++br) {
+        const int r0 = br * K;
+        const int nr = std::min(K, A.rows - r0);
+        std::fill_n(C + static_cast<std::size_t>(r0) * colsB, static_cast<std::size_t>(nr) * colsB, 0.0);
+        for (int b = A.row_ptr[br]; b < A.row_ptr[br + 1]; ++b) {
+            const double* blk = A.values.data() + static_cast<std::size_t>(b) * K * K;
+            const int c0 = A.col_idx[b] * K;
+            const int nc = std::min(K, A.cols - c0);
+            for (int r = 0; r < nr; ++r) {
+                double* c = C + static_cast<std::size_t>(r0 + r) * colsB;
+                for (int k = 0; k < nc; ++k) {
+                    const double a = blk[r * K + k];
+                    const double* brow = B + static_cast<std::size_t>(c0 + k) * colsB;
+                    for (int j = 0; j < colsB; ++j) {
+                        c[j] += a * brow[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+// parts + 1 row boundaries, each range holding about the same number of
+// entries of row_ptr (non-zeros for CSR, blocks for BSR)
+std::vector<int> balanced_splits(const std::vector<int>& row_ptr, int parts) {
+    const int rows = static_cast<int>(row_ptr.size()) - 1;
+    const long long total = row_ptr.back();
+    std::vector<int> splits(parts + 1, rows);
+    splits[0] = 0;
+    for (int p = 1; p < parts; ++p) {
+        const long long target = total * p / parts;
+        int row = static_cast<int>(std::lower_bound(row_ptr.begin(), row_ptr.end(), target) - row_ptr.begin());
+        splits[p] = std::clamp(row, splits[p - 1], rows);
+    }
+    return splits;
+}
+
+template <typename Body>
+void parallel_rows(const std::vector<int>& row_ptr, ThreadPool& pool, Body body) {
+    if (row_ptr.size() < 2) {
+        return;
+    }
+    const int parts = static_cast<int>(pool.size());
+    const std::vector<int> splits = balanced_splits(row_ptr, parts);
+    pool.parallel_for(0, parts, 1, [&](int lo, int hi) {
+        for (int p = lo; p < hi; ++p) {
+            body(splits[p], splits[p + 1]);
+        }
+    });
+}
+
+} // namespace
+
+double BsrMatrix::fill_ratio(std::size_t true_nnz) const {
+    return true_nnz == 0 ? 0.0 : static_cast<double>(blocks() * K * K) / static_cast<double>(true_nnz);
+}
+
+CsrMatrix dense_to_csr(ConstMatrixView dense, double tolerance) {
+    CsrMatrix out;
+    out.rows = dense.rows();
+    out.cols = dense.cols();
+    out.row_ptr.reserve(out.rows + 1);
+    out.row_ptr.push_back(0);
+    for (int i = 0; i < out.rows; ++i) {
+        const double* row = dense.line(i);
+        for (int j = 0; j < out.cols; ++j) {
+            if (std::abs(row[j]) > tolerance) {
+                out.col_idx.push_back(j);
+                out.values.push_back(row[j]);
+            }
+        }
+        out.row_ptr.push_back(static_cast<int>(out.values.size()));
+    }
+    return out;
+}
+
+CsrMatrix dense_to_csr(const double* dense, int rows, int cols, double tolerance) {
+    check_null(dense, "dense");
+    return dense_to_csr(ConstMatrixView(dense, rows, cols), tolerance);
+}
+
+BsrMatrix csr_to_bsr(const CsrMatrix& csr) {
+    BsrMatrix out;
+    out.rows = csr.rows;
+    out.cols = csr.cols;
+    out.block_rows = (csr.rows + K - 1) / K;
+    out.block_cols = (csr.cols + K - 1) / K;
+    out.row_ptr.reserve(out.block_rows + 1);
+    out.row_ptr.push_back(0);
+
+    // slot[bc]: index of block column bc's block within the current block row
+    std::vector<int> slot(out.block_cols, -1);
+    std::vector<int> touched;
+    for (int br = 0; br < out.block_rows; ++br) {
+        const int r0 = br * K;
+        const int r1 = std::min(r0 + K, csr.rows);
+        for (int i = r0; i < r1; ++i) {
+            for (int e = csr.row_ptr[i]; e < csr.row_ptr[i + 1]; ++e) {
+                int bc = csr.col_idx[e] / K;
+                if (slot[bc] < 0) {
+                    slot[bc] = 0;
+                    touched.push_back(bc);
+                }
+            }
+        }
+        std::sort(touched.begin(), touched.end());
+        const int first = static_cast<int>(out.col_idx.size());
+        for (std::size_t t = 0; t < touched.size(); ++t) {
+            slot[touched[t]] = first + static_cast<int>(t);
+            out.col_idx.push_back(touched[t]);
+        }
+        out.values.resize(out.col_idx.size() * K * K, 0.0);
+        for (int i = r0; i < r1; ++i) {
+            for (int e = csr.row_ptr[i]; e < csr.row_ptr[i + 1]; ++e) {
+                int j = csr.col_idx[e];
+                out.values[static_cast<std::size_t>(slot[j / K]) * K * K + (i - r0) * K + j % K] = csr.values[e];
+            }
+        }
+        for (int bc : touched) {
+            slot[bc] = -1;
+        }
+        touched.clear();
+        out.row_ptr.push_back(static_cast<int>(out.col_idx.size()));
+    }
+    return out;
+}
+
+BsrMatrix dense_to_bsr(ConstMatrixView dense, double tolerance) {
+    return csr_to_bsr(dense_to_csr(dense, tolerance));
+}
+
+BsrMatrix dense_to_bsr(const double* dense, int rows, int cols, double tolerance) {
+    check_null(dense, "dense");
+    return dense_to_bsr(ConstMatrixView(dense, rows, cols), tolerance);
+}
+
+void spmv(const CsrMatrix& A, const double* x, double* y) {
+    check_null(x, "vector");
+    check_null(y, "result");
+    csr_spmv_rows(A, x, y, 0, A.rows);
+}
+
+void spmv(const BsrMatrix& A, const double* x, double* y) {
+    check_null(x, "vector");
+    check_null(y, "result");
+    bsr_spmv_rows(A, x, y, 0, A.block_rows);
+}
+
+void spmm(const CsrMatrix& A, const double* B, int colsB, double* C) {
+    check_spmm_args(B, colsB, C);
+    csr_spmm_rows(A, B, colsB, C, 0, A.rows);
+}
+
+void spmm(const BsrMatrix& A, const double* B, int colsB, double* C) {
+    check_spmm_args(B, colsB, C);
+    bsr_spmm_rows(A, B, colsB, C, 0, A.block_rows);
+}
+
+void spmv_parallel(const CsrMatrix& A, const double* x, double* y, ThreadPool& pool) {
+    check_null(x, "vector");
+    check_null(y, "result");
+    parallel_rows(A.row_ptr, pool, [&](int lo, int hi) { csr_spmv_rows(A, x, y, lo, hi); });
+}
+
+void spmv_parallel(const BsrMatrix& A, const double* x, double* y, ThreadPool& pool) {
+    check_null(x, "vector");
+    check_null(y, "result");
+    parallel_rows(A.row_ptr, pool, [&](int lo, int hi) { bsr_spmv_rows(A, x, y, lo, hi); });
+}
+
+void spmm_parallel(const CsrMatrix& A, const double* B, int colsB, double* C, ThreadPool& pool) {
+    check_spmm_args(B, colsB, C);
+    parallel_rows(A.row_ptr, pool, [&](int lo, int hi) { csr_spmm_rows(A, B, colsB, C, lo, hi); });
+}
+
+void spmm_parallel(const BsrMatrix& A, const double* B, int colsB, double* C, ThreadPool& pool) {
+    check_spmm_args(B, colsB, C);
+    parallel_rows(A.row_ptr, pool, [&](int lo, int hi) { bsr_spmm_rows(A, B, colsB, C, lo, hi); });
+}
@@ -0,0 +1,78 @@
+#ifndef SPARSE_H
+#define SPARSE_H
+
+#include <cstddef>
+#include <vector>
+#include "alignment.h"
+#include "matrix_ops.h"
+#include "thread_pool.h"
+
+// Sparse counterparts of the dense kernels in matrix_ops.h, for matrices that
+// are mostly zeros. Dense operands (x, y, B, C) are plain row-major buffers.
+
+// Compressed sparse row: the non-zeros of row i are values[row_ptr[i] ..
+// row_ptr[i + 1]) in columns col_idx[...], sorted by column
+struct CsrMatrix {
+    int rows = 0;
+    int cols = 0;
+    std::vector<int> row_ptr;
+    std::vector<int> col_idx;
+    std::vector<double> values;
+
+    std::size_t nnz() const { return values.size(); }
+};
+
+// Block sparse row with dense kBlock x kBlock blocks (row-major inside the
+// block, 64-byte aligned). Any block holding a non-zero is stored whole, so
+// the inner loops have fixed trip counts and vectorise; the price is the
+// explicit zeros inside each block (see fill_ratio). Edge blocks of a matrix
+// whose sides are not multiples of kBlock are zero padded.
+struct BsrMatrix {
+    static constexpr int kBlock = 4;
+
+    int rows = 0;
+    int cols = 0;
+    int block_rows = 0;
+    int block_cols = 0;
+    std::vector<int> row_ptr;  // per block row
+    std::vector<int> col_idx;  // block column of each stored block
+    AlignedVector<double> values;
+
+    std::size_t blocks() const { return col_idx.size(); }
+    // Stored values per true non-zero (1.0 = no padding)
+    double fill_ratio(std::size_t true_nnz) const;
+};
+
+// Entries with |a_ij| <= tolerance are dropped
+CsrMatrix dense_to_csr(ConstMatrixView dense, double tolerance = 0.0);
+
+CsrMatrix dense_to_csr(const double* dense, int rows, int cols, double tolerance = 0.0);
+
+BsrMatrix dense_to_bsr(ConstMatrixView dense, double tolerance = 0.0);
+
+BsrMatrix dense_to_bsr(const double* dense, int rows, int cols, double tolerance = 0.0);
+
+BsrMatrix csr_to_bsr(const CsrMatrix& csr);
+
+// y (rows) = A * x (cols)
+void spmv(const CsrMatrix& A, const double* x, double* y);
+
+void spmv(const BsrMatrix& A, const double* x, double* y);
+
+// C (rows x colsB) = A * B (cols x colsB)
+void spmm(const CsrMatrix& A, const double* B, int colsB, double* C);
+
+void spmm(const BsrMatrix& A, const double* B, int colsB, double* C);
+
+// Multithreaded versions. Rows (block rows for BSR) are split into one range
+// per pool participant holding roughly equal numbers of non-zeros, so a few
+// dense rows do not leave the other threads idle.
+void spmv_parallel(const CsrMatrix& A, const double* x, double* y, ThreadPool& pool);
+
+void spmv_parallel(const BsrMatrix& A, const double* x, double* y, ThreadPool& pool);
+
+void spmm_parallel(const CsrMatrix& A, const double* B, int colsB, double* C, ThreadPool& pool);
+
+void spmm_parallel(const BsrMatrix& A, const double* B, int colsB, double* C, ThreadPool& pool);
+
+#endif
@@ -0,0 +1,109 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+ThreadPool::ThreadPool(unsigned num_threads, bool pin_threads) {
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+    workers_.reserve(num_threads - 1);
+    for (unsigned i = 1; i < num_threads; ++i) {
+        workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+#ifdef __linux__
+        if (pin_threads) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(i % std::max(1u, std::thread::hardware_concurrency()), &set);
+            pthread_setaffinity_np(workers_.back().native_handle(), sizeof(set), &set);
+        }
+#else
+        (void)pin_threads;
+#endif
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& t : workers_) {
+        t.join();
+    }
+}
+
+void ThreadPool::parallel_for(int begin, int end, int grain, const std::function<void(int, int)>& body) {
+    if (end <= begin) {
+        return;
+    }
+    const int range = end - begin;
+    if (grain <= 0) {
+        grain = (range + static_cast<int>(size()) - 1) / static_cast<int>(size());
+    }
+    if (workers_.empty() || grain >= range) {
+        body(begin, end);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(submit_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        begin_ = begin;
+        end_ = end;
+        grain_ = grain;
+        error_ = nullptr;
+        pending_ = static_cast<unsigned>(workers_.size());
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    run_chunks(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return pending_ == 0; });
+    body_ = nullptr;
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void ThreadPool::worker_loop(unsigned participant) {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        run_chunks(participant);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run_chunks(unsigned participant) {
+    const int stride = grain_ * static_cast<int>(size());
+    try {
+        for (int lo = begin_ + grain_ * static_cast<int>(participant); lo < end_; lo += stride) {
+            (*body_)(lo, std::min(lo + grain_, end_));
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+            error_ = std::current_exception();
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that live as long as the pool, so a parallel
+// kernel call only pays a wake-up, never a thread creation.
+//
+// parallel_for splits [begin, end) into grain-sized chunks and always hands
+// chunk c to participant c % size() (participant 0 is the calling thread).
+// Because the mapping is static, the thread that first-touches a range of
+// the output is the same one that later computes it, which keeps pages on
+// that thread's NUMA node.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned num_threads = std::thread::hardware_concurrency(), bool pin_threads = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of participants, including the calling thread
+    unsigned size() const { return static_cast<unsigned>(workers_.size()) + 1; }
+
+    // grain <= 0 picks one contiguous chunk per participant
+    void parallel_for(int begin, int end, int grain, const std::function<void(int, int)>& body);
+
+private:
+    void worker_loop(unsigned participant);
+    void run_chunks(unsigned participant);
+
+    std::vector<std::thread> workers_;
+    std::mutex submit_mutex_;    // one parallel_for at a time
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    std::uint64_t generation_ = 0;
+    unsigned pending_ = 0;
+    bool stop_ = false;
+
+    // Current job, published under mutex_ before generation_ is bumped
+    const std::function<void(int, int)>* body_ = nullptr;
+    int begin_ = 0;
+    int end_ = 0;
+    int grain_ = 1;
+    std::exception_ptr error_;
+};
+
+#endif
@@ -0,0 +1,159 @@
+#include "matrix_ops.h"
+#include "cpu_info.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TRANSPOSE_HAVE_X86 1
+#endif
+
+namespace {
+
+// Recursion stops once a block is at most kBase x kBase: 32*32 doubles of
+// source plus destination is 16KB, inside any L1
+constexpr int kBase = 32;
+
+using BaseKernel = void (*)(const double* src, int ld_src, double* dst, int ld_dst, int rows, int cols);
+
+void transpose_base_scalar(const double* src, int ld_src, double* dst, int ld_dst, int rows, int cols) {
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            dst[j * ld_dst + i] = src[i * ld_src + j];
+        }
+    }
+}
+
+#ifdef TRANSPOSE_HAVE_X86
+// 4x4 register transpose: four row loads, two shuffle stages, four row stores
+__attribute__((target("avx2")))
+inline void transpose_4x4_avx2(const double* src, int ld_src, double* dst, int ld_dst) {
+    const __m256d r0 = _mm256_loadu_pd(src);
+    const __m256d r1 = _mm256_loadu_pd(src + ld_src);
+    const __m256d r2 = _mm256_loadu_pd(src + 2 * ld_src);
+    const __m256d r3 = _mm256_loadu_pd(src + 3 * ld_src);
+
+    const __m256d t0 = _mm256_unpacklo_pd(r0, r1); // a0 b0 a2 b2
+    const __m256d t1 = _mm256_unpackhi_pd(r0, r1); // a1 b1 a3 b3
+    const __m256d t2 = _mm256_unpacklo_pd(r2, r3); // c0 d0 c2 d2
+    const __m256d t3 = _mm256_unpackhi_pd(r2, r3); // c1 d1 c3 d3
+
+    _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));              // a0 b0 c0 d0
+    _mm256_storeu_pd(dst + ld_dst, _mm256_permute2f128_pd(t1, t3, 0x20));     // a1 b1 c1 d1
+    _mm256_storeu_pd(dst + 2 * ld_dst, _mm256_permute2f128_pd(t0, t2, 0x31)); // a2 b2 c2 d2
+    _mm256_storeu_pd(dst + 3 * ld_dst, _mm256_permute2f128_pd(t1, t3, 0x31)); // a3 b3 c3 d3
+}
+
+__attribute__((target("avx2")))
+void transpose_base_avx2(const double* src, int ld_src, double* dst, int ld_dst, int rows, int cols) {
+    const int rows4 = rows / 4 * 4;
+    const int cols4 = cols / 4 * 4;
+    for (int i = 0; i < rows4; i += 4) {
+        for (int j = 0; j < cols4; j += 4) {
+            transpose_4x4_avx2(src + i * ld_src + j, ld_src, dst + j * ld_dst + i, ld_dst);
+        }
+    }
+    // Ragged right edge and bottom edge
+    if (cols4 < cols) {
+        transpose_base_scalar(src + cols4, ld_src, dst + cols4 * ld_dst, ld_dst, rows4, cols - cols4);
+    }
+    if (rows4 < rows) {
+        transpose_base_scalar(src + rows4 * ld_src, ld_src, dst + rows4, ld_dst, rows - rows4, cols);
+    }
+}
+#endif
+
+BaseKernel select_base() {
+#ifdef TRANSPOSE_HAVE_X86
+    if (cpu_info().has_avx2) {
+        return transpose_base_avx2;
+    }
+#endif
+    return transpose_base_scalar;
+}
+
+BaseKernel base_kernel() {
+    static const BaseKernel kernel = select_base();
+    return kernel;
+}
+
+// Halve the longer side until the block fits the base case; split points stay
+// on multiples of 4 so the SIMD tiles line up across the whole matrix
+void transpose_recursive(const double* src, int ld_src, double* dst, int ld_dst, int rows, int cols, BaseKernel base) {
+    if (rows <= kBase && cols <= kBase) {
+        base(src, ld_src, dst, ld_dst, rows, cols);
+        return;
+    }
+    if (rows >= cols) {
+        int half = std::max(4, rows / 2 / 4 * 4);
+        transpose_recursive(src, ld_src, dst, ld_dst, half, cols, base);
+        transpose_recursive(src + static_cast<size_t>(half) * ld_src, ld_src, dst + half, ld_dst, rows - half, cols, base);
+    } else {
+        int half = std::max(4, cols / 2 / 4 * 4);
+        transpose_recursive(src, ld_src, dst, ld_dst, rows, half, base);
+        transpose_recursive(src + half, ld_src, dst + static_cast<size_t>(half) * ld_dst, ld_dst, rows, cols - half, base);
+    }
+}
+
+} // namespace
+
+void transpose(const double* src, int rows, int cols, int ld_src, double* dst, int ld_dst) {
+    if (!src || !dst) {
+        throw std::invalid_argument("Transpose pointers cannot be null.");
+    }
+    if (rows < 0 || cols < 0 || ld_src < cols || ld_dst < rows) {
+        throw std::invalid_argument("Invalid dimensions for transpose.");
+    }
+    transpose_recursive(src, ld_src, dst, ld_dst, rows, cols, base_kernel());
+}
+
+void transpose(ConstMatrixView src, MutableMatrixView dst) {
+    if (dst.rows() != src.cols() || dst.cols() != src.rows()) {
+        throw std::invalid_argument("Transpose destination must be cols x rows of the source.");
+    }
+    transpose(src.data(), src.rows(), src.cols(), src.ld(), dst.data(), dst.ld());
+}
+
+void transpose_in_place(double* matrix, int n, int ld) {
+    if (!matrix) {
+        throw std::invalid_argument("matrix cannot be null.");
+    }
+    if (n < 0 || ld < n) {
+        throw std::invalid_argument("Invalid dimensions for in-place transpose.");
+    }
+    BaseKernel base = base_kernel();
+    alignas(64) double tmp[kBase * kBase];
+
+    for (int i0 = 0; i0 < n; i0 += kBase) {
+        const int bi = std::min(kBase, n - i0);
+
+        // Diagonal tile: swap across its own diagonal
+        for (int i = i0; i < i0 + bi; ++i) {
+            for (int j = i + 1; j < i0 + bi; ++j) {
+                std::swap(matrix[static_cast<size_t>(i) * ld + j], matrix[static_cast<size_t>(j) * ld + i]);
+            }
+        }
+
+        // Off-diagonal pair (i0, j0) <-> (j0, i0): stash one transposed tile,
+        // transpose the mirror tile into its place, then drop the stash in
+        for (int j0 = i0 + kBase; j0 < n; j0 += kBase) {
+            const int bj = std::min(kBase, n - j0);
+            double* upper = matrix + static_cast<size_t>(i0) * ld + j0; // bi x bj
+            double* lower = matrix + static_cast<size_t>(j0) * ld + i0; // bj x bi
+            base(upper, ld, tmp, kBase, bi, bj);  // tmp: bj x bi
+            base(lower, ld, upper, ld, bj, bi);
+            for (int r = 0; r < bj; ++r) {
+                std::copy_n(tmp + r * kBase, bi, lower + r * ld);
+            }
+        }
+    }
+}
+
+void transpose_in_place(MutableMatrixView matrix) {
+    if (matrix.rows() != matrix.cols()) {
+        throw std::invalid_argument("In-place transpose requires a square matrix.");
+    }
+    transpose_in_place(matrix.data(), matrix.rows(), matrix.ld());
+}
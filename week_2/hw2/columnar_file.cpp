@@ -0,0 +1,358 @@
+#include "columnar_file.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// All multi-byte fields are written in host byte order (little-endian on
+// every platform this project targets).
+
+namespace {
+
+constexpr char kMagic[8] = {'H', 'F', 'T', 'C', 'O', 'L', 'M', 'N'};
+constexpr std::size_t kHeaderBytes = 64;
+constexpr std::size_t kDescriptorBytes = 32;
+constexpr std::size_t kNameBytes = 16;
+constexpr std::uint16_t kFlagCompressed = 1;
+
+std::size_t widthOf(ColumnType type) {
+    switch (type) {
+        case ColumnType::I32: return 4;
+        case ColumnType::I64: return 8;
+        case ColumnType::F64: return 8;
+        case ColumnType::U8: return 1;
+    }
+    throw std::runtime_error("Unknown column type.");
+}
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + 63) / 64 * 64;
+}
+
+template <typename T>
+void put(unsigned char* dst, T value) {
+    std::memcpy(dst, &value, sizeof(T));
+}
+
+template <typename T>
+T get(const unsigned char* src) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+}
+
+// --- Block encoding ---
+
+void putVarint(std::vector<unsigned char>& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<unsigned char>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(v));
+}
+
+std::uint64_t getVarint(const unsigned char*& p, const unsigned char* end) {
+    std::uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) {
+            throw std::runtime_error("Truncated compressed column block.");
+        }
+        unsigned char byte = *p++;
+        v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return v;
+        }
+    }
+    throw std::runtime_error("Malformed varint in compressed column block.");
+}
+
+std::int64_t loadInteger(const unsigned char* src, ColumnType type) {
+    switch (type) {
+        case ColumnType::I32: return get<std::int32_t>(src);
+        case ColumnType::I64: return get<std::int64_t>(src);
+        case ColumnType::U8: return *src;
+        default: return 0;
+    }
+}
+
+void storeInteger(unsigned char* dst, ColumnType type, std::int64_t v) {
+    switch (type) {
+        case ColumnType::I32: put(dst, static_cast<std::int32_t>(v)); break;
+        case ColumnType::I64: put(dst, v); break;
+        case ColumnType::U8: *dst = static_cast<unsigned char>(v); break;
+        default: break;
+    }
+}
+
+// Integers: zigzag varint of the delta to the previous value. Doubles: the
+// XOR with the previous value's bits, as a byte count plus only the
+// non-zero low-order bytes (repeated values cost one byte).
+void encodeBlock(std::vector<unsigned char>& out, const unsigned char* src, std::size_t count, ColumnType type) {
+    const std::size_t width = widthOf(type);
+    if (type == ColumnType::F64) {
+        std::uint64_t prev = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::uint64_t bits = get<std::uint64_t>(src + i * width);
+            std::uint64_t x = bits ^ prev;
+            prev = bits;
+            unsigned char bytes = 0;
+            for (std::uint64_t t = x; t != 0; t >>= 8) {
+                ++bytes;
+            }
+            out.push_back(bytes);
+            for (unsigned char b = 0; b < bytes; ++b) {
+                out.push_back(static_cast<unsigned char>(x >> (8 * b)));
+            }
+        }
+        return;
+    }
+    std::int64_t prev = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::int64_t v = loadInteger(src + i * width, type);
+        std::uint64_t delta = static_cast<std::uint64_t>(v) - static_cast<std::uint64_t>(prev);
+        prev = v;
+        std::int64_t signed_delta = static_cast<std::int64_t>(delta);
+        putVarint(out, (delta << 1) ^ static_cast<std::uint64_t>(signed_delta >> 63));
+    }
+}
+
+void decodeBlock(const unsigned char* p, const unsigned char* end, unsigned char* dst, std::size_t count, ColumnType type) {
+    const std::size_t width = widthOf(type);
+    if (type == ColumnType::F64) {
+        std::uint64_t prev = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (p == end || *p > 8 || static_cast<std::size_t>(end - p) < 1u + *p) {
+                throw std::runtime_error("Truncated compressed column block.");
+            }
+            unsigned char bytes = *p++;
+            std::uint64_t x = 0;
+            for (unsigned char b = 0; b < bytes; ++b) {
+                x |= static_cast<std::uint64_t>(*p++) << (8 * b);
+            }
+            prev ^= x;
+            put(dst + i * width, prev);
+        }
+        return;
+    }
+    std::uint64_t prev = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t zigzag = getVarint(p, end);
+        std::uint64_t delta = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+        prev += delta;
+        storeInteger(dst + i * width, type, static_cast<std::int64_t>(prev));
+    }
+}
+
+} // namespace
+
+void writeColumnarFile(const std::string& path, RecordKind kind, const std::vector<ColumnSpec>& columns,
+                       std::uint64_t rows, bool compress) {
+    const std::size_t column_count = columns.size();
+    const std::uint64_t block_count = compress ? (rows + kColumnarBlockRows - 1) / kColumnarBlockRows : 0;
+    const std::size_t meta_bytes = kHeaderBytes + column_count * kDescriptorBytes;
+
+    std::vector<unsigned char> meta(meta_bytes, 0);
+    std::memcpy(meta.data(), kMagic, sizeof(kMagic));
+    put(meta.data() + 8, kColumnarVersion);
+    put(meta.data() + 10, static_cast<std::uint16_t>(kind));
+    put(meta.data() + 12, static_cast<std::uint16_t>(column_count));
+    put(meta.data() + 14, static_cast<std::uint16_t>(compress ? kFlagCompressed : 0));
+    put(meta.data() + 16, rows);
+    put(meta.data() + 24, kColumnarBlockRows);
+    put(meta.data() + 28, static_cast<std::uint32_t>(block_count));
+
+    std::uint64_t offset = alignUp(meta_bytes);
+    for (std::size_t c = 0; c < column_count; ++c) {
+        if (columns[c].name.size() >= kNameBytes) {
+            throw std::runtime_error("Column name too long: " + columns[c].name);
+        }
+        unsigned char* desc = meta.data() + kHeaderBytes + c * kDescriptorBytes;
+        std::memcpy(desc, columns[c].name.data(), columns[c].name.size());
+        desc[16] = static_cast<unsigned char>(columns[c].type);
+        desc[17] = static_cast<unsigned char>(widthOf(columns[c].type));
+        if (!compress) {
+            put(desc + 24, offset);
+            offset = alignUp(offset + rows * widthOf(columns[c].type));
+        }
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open " + path + " for writing.");
+    }
+    out.write(reinterpret_cast<const char*>(meta.data()), meta.size());
+
+    const char zeros[64] = {};
+    if (!compress) {
+        std::uint64_t written = meta_bytes;
+        for (const ColumnSpec& column : columns) {
+            std::uint64_t start = alignUp(written);
+            out.write(zeros, static_cast<std::streamsize>(start - written));
+            std::uint64_t bytes = rows * widthOf(column.type);
+            out.write(static_cast<const char*>(column.data), static_cast<std::streamsize>(bytes));
+            written = start + bytes;
+        }
+    } else {
+        // Block directory: {offset, bytes} per block per column, filled in
+        // once the blocks have been written
+        std::vector<std::uint64_t> directory(block_count * column_count * 2, 0);
+        const std::uint64_t directory_at = alignUp(meta_bytes);
+        out.write(zeros, static_cast<std::streamsize>(directory_at - meta_bytes));
+        out.write(reinterpret_cast<const char*>(directory.data()), static_cast<std::streamsize>(directory.size() * 8));
+        std::uint64_t written = directory_at + directory.size() * 8;
+
+        std::vector<unsigned char> encoded;
+        for (std::uint64_t b = 0; b < block_count; ++b) {
+            const std::uint64_t first = b * kColumnarBlockRows;
+            const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(kColumnarBlockRows, rows - first));
+            for (std::size_t c = 0; c < column_count; ++c) {
+                const std::size_t width = widthOf(columns[c].type);
+                encoded.clear();
+                encodeBlock(encoded, static_cast<const unsigned char*>(columns[c].data) + first * width, count, columns[c].type);
+                directory[(b * column_count + c) * 2] = written;
+                directory[(b * column_count + c) * 2 + 1] = encoded.size();
+                out.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+                written += encoded.size();
+            }
+        }
+        out.seekp(static_cast<std::streamoff>(directory_at));
+        out.write(reinterpret_cast<const char*>(directory.data()), static_cast<std::streamsize>(directory.size() * 8));
+    }
+    if (!out) {
+        throw std::runtime_error("Failed writing " + path + ".");
+    }
+}
+
+ColumnarFile::ColumnarFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path + ".");
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(kHeaderBytes)) {
+        ::close(fd);
+        throw std::runtime_error(path + " is too small to be a columnar file.");
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map " + path + ".");
+    }
+    map_ = static_cast<const unsigned char*>(mapping);
+    ::madvise(mapping, size_, MADV_SEQUENTIAL);
+
+    try {
+        if (std::memcmp(map_, kMagic, sizeof(kMagic)) != 0) {
+            throw std::runtime_error(path + " is not a columnar file.");
+        }
+        if (get<std::uint16_t>(map_ + 8) != kColumnarVersion) {
+            throw std::runtime_error(path + " has unsupported format version " + std::to_string(get<std::uint16_t>(map_ + 8)) + ".");
+        }
+        kind_ = static_cast<RecordKind>(get<std::uint16_t>(map_ + 10));
+        const std::size_t column_count = get<std::uint16_t>(map_ + 12);
+        compressed_ = (get<std::uint16_t>(map_ + 14) & kFlagCompressed) != 0;
+        rows_ = get<std::uint64_t>(map_ + 16);
+        const std::size_t meta_bytes = kHeaderBytes + column_count * kDescriptorBytes;
+        if (size_ < meta_bytes) {
+            throw std::runtime_error(path + " is truncated.");
+        }
+
+        for (std::size_t c = 0; c < column_count; ++c) {
+            const unsigned char* desc = map_ + kHeaderBytes + c * kDescriptorBytes;
+            Column column;
+            column.name.assign(reinterpret_cast<const char*>(desc), strnlen(reinterpret_cast<const char*>(desc), kNameBytes));
+            column.type = static_cast<ColumnType>(desc[16]);
+            if (desc[17] != widthOf(column.type)) {
+                throw std::runtime_error(path + ": column " + column.name + " has an inconsistent width.");
+            }
+            column.data = nullptr;
+            if (!compressed_) {
+                std::uint64_t offset = get<std::uint64_t>(desc + 24);
+                if (offset % 8 != 0 || offset > size_ || rows_ > (size_ - offset) / desc[17]) {
+                    throw std::runtime_error(path + ": column " + column.name + " lies outside the file.");
+                }
+                column.data = map_ + offset;
+            }
+            columns_.push_back(column);
+        }
+        if (compressed_) {
+            decodeBlocks(map_ + alignUp(meta_bytes), column_count);
+        }
+    } catch (...) {
+        ::munmap(const_cast<unsigned char*>(map_), size_);
+        throw;
+    }
+}
+
+ColumnarFile::~ColumnarFile() {
+    ::munmap(const_cast<unsigned char*>(map_), size_);
+}
+
+void ColumnarFile::decodeBlocks(const unsigned char* directory, std::size_t column_count) {
+    const std::uint64_t block_rows = get<std::uint32_t>(map_ + 24);
+    const std::uint64_t block_count = get<std::uint32_t>(map_ + 28);
+    if (block_rows == 0 || block_count != (rows_ + block_rows - 1) / block_rows ||
+        static_cast<std::uint64_t>(directory - map_) + block_count * column_count * 16 > size_) {
+        throw std::runtime_error("Corrupt block directory in columnar file.");
+    }
+    decoded_.resize(column_count);
+    for (std::size_t c = 0; c < column_count; ++c) {
+        const std::size_t width = widthOf(columns_[c].type);
+        decoded_[c].resize((rows_ * width + 7) / 8);
+        unsigned char* dst = reinterpret_cast<unsigned char*>(decoded_[c].data());
+        for (std::uint64_t b = 0; b < block_count; ++b) {
+            const unsigned char* entry = directory + (b * column_count + c) * 16;
+            std::uint64_t offset = get<std::uint64_t>(entry);
+            std::uint64_t bytes = get<std::uint64_t>(entry + 8);
+            if (offset > size_ || bytes > size_ - offset) {
+                throw std::runtime_error("Compressed block lies outside the columnar file.");
+            }
+            const std::uint64_t first = b * block_rows;
+            const std::size_t count = static_cast<std::size_t>(std::min(block_rows, rows_ - first));
+            decodeBlock(map_ + offset, map_ + offset + bytes, dst + first * width, count, columns_[c].type);
+        }
+        columns_[c].data = dst;
+    }
+}
+
+const void* ColumnarFile::column(const std::string& name, ColumnType type) const {
+    for (const Column& c : columns_) {
+        if (c.name == name) {
+            if (c.type != type) {
+                throw std::runtime_error("Column " + name + " has an unexpected type.");
+            }
+            return c.data;
+        }
+    }
+    throw std::runtime_error("Columnar file has no column " + name + ".");
+}
+
+TickColumns ColumnarFile::ticks() const {
+    if (kind_ != RecordKind::Tick) {
+        throw std::runtime_error("Columnar file does not hold ticks.");
+    }
+    return {
+        static_cast<const std::int32_t*>(column("instrument_id", ColumnType::I32)),
+        static_cast<const std::int32_t*>(column("price_ticks", ColumnType::I32)),
+        static_cast<const std::int64_t*>(column("timestamp_ns", ColumnType::I64)),
+        static_cast<std::size_t>(rows_)
+    };
+}
+
+OrderColumns ColumnarFile::orders() const {
+    if (kind_ != RecordKind::Order) {
+        throw std::runtime_error("Columnar file does not hold orders.");
+    }
+    return {
+        static_cast<const std::int32_t*>(column("instrument_id", ColumnType::I32)),
+        static_cast<const std::int32_t*>(column("price_ticks", ColumnType::I32)),
+        static_cast<const std::uint8_t*>(column("is_buy", ColumnType::U8)),
+        static_cast<const std::int64_t*>(column("timestamp_ns", ColumnType::I64)),
+        static_cast<const std::uint8_t*>(column("signal", ColumnType::U8)),
+        static_cast<std::size_t>(rows_)
+    };
+}
@@ -0,0 +1,95 @@
+#ifndef COLUMNAR_FILE_H
+#define COLUMNAR_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary columnar files for tick and order history.
+//
+// Layout: a 64-byte header (magic, format version, record kind, row count,
+// flags), one 32-byte descriptor per column (name, type, width, offset),
+// then the column data. Uncompressed files store each column as one
+// contiguous, 64-byte aligned array, so a memory-mapped reader hands out
+// pointers straight into the page cache. Compressed files split the rows
+// into blocks and encode each column block on its own: integers as zigzag
+// varint deltas, doubles as the non-zero bytes of the XOR with the previous
+// value. Timestamps are nanoseconds since the clock's epoch.
+
+enum class RecordKind : std::uint16_t { Tick = 1, Order = 2 };
+
+enum class ColumnType : std::uint8_t { I32 = 1, I64 = 2, F64 = 3, U8 = 4 };
+
+struct ColumnSpec {
+    std::string name;
+    ColumnType type;
+    const void* data;  // rows values of `type`
+};
+
+constexpr std::uint16_t kColumnarVersion = 1;
+constexpr std::uint32_t kColumnarBlockRows = 64 * 1024;
+
+// Throws std::runtime_error on I/O failure
+void writeColumnarFile(const std::string& path, RecordKind kind, const std::vector<ColumnSpec>& columns,
+                       std::uint64_t rows, bool compress);
+
+// Zero-copy column views over a ColumnarFile
+struct TickColumns {
+    const std::int32_t* instrument_id;
+    const std::int32_t* price_ticks;
+    const std::int64_t* timestamp_ns;
+    std::size_t size;
+};
+
+struct OrderColumns {
+    const std::int32_t* instrument_id;
+    const std::int32_t* price_ticks;
+    const std::uint8_t* is_buy;
+    const std::int64_t* timestamp_ns;
+    const std::uint8_t* signal;
+    std::size_t size;
+};
+
+// Read-only memory mapping of a columnar file. Uncompressed columns point
+// into the mapping; compressed ones are decoded once, on open, into
+// buffers owned by the reader. Throws std::runtime_error if the file is
+// missing, truncated or not in this format.
+class ColumnarFile {
+public:
+    explicit ColumnarFile(const std::string& path);
+    ~ColumnarFile();
+
+    ColumnarFile(const ColumnarFile&) = delete;
+    ColumnarFile& operator=(const ColumnarFile&) = delete;
+
+    RecordKind kind() const { return kind_; }
+    std::uint64_t rows() const { return rows_; }
+    bool compressed() const { return compressed_; }
+    std::size_t fileSize() const { return size_; }
+
+    // Column by name; throws if missing or of a different type
+    const void* column(const std::string& name, ColumnType type) const;
+
+    TickColumns ticks() const;
+    OrderColumns orders() const;
+
+private:
+    struct Column {
+        std::string name;
+        ColumnType type;
+        const void* data;
+    };
+
+    const unsigned char* map_ = nullptr;
+    std::size_t size_ = 0;
+    RecordKind kind_ = RecordKind::Tick;
+    std::uint64_t rows_ = 0;
+    bool compressed_ = false;
+    std::vector<Column> columns_;
+    std::vector<std::vector<std::uint64_t>> decoded_;  // 8-byte aligned storage
+
+    void decodeBlocks(const unsigned char* directory, std::size_t column_count);
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef INSTRUMENT_REGISTRY_H
+#define INSTRUMENT_REGISTRY_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Maps sparse instrument IDs to dense indices 0..size()-1 so per-instrument
+// state can live in plain arrays. IDs are registered up front; lookups are a
+// bounds check plus one load from a direct-mapped table covering
+// [min id, max id].
+class InstrumentRegistry {
+public:
+    // Largest max id - min id + 1 the lookup table may span
+    static constexpr int kMaxIdRange = 1 << 20;
+
+    // Returns the dense index of instrument_id, registering it if new
+    int add(int instrument_id) {
+        int existing = index(instrument_id);
+        if (existing >= 0) {
+            return existing;
+        }
+        if (table.empty()) {
+            base_id = instrument_id;
+        }
+        long long lo = std::min<long long>(base_id, instrument_id);
+        long long hi = std::max<long long>(base_id + static_cast<long long>(table.size()) - 1, instrument_id);
+        if (hi - lo + 1 > kMaxIdRange) {
+            throw std::invalid_argument("Instrument id " + std::to_string(instrument_id) + " is too far from the registered range.");
+        }
+        if (instrument_id < base_id) {
+            table.insert(table.begin(), static_cast<std::size_t>(base_id - instrument_id), -1);
+            base_id = instrument_id;
+        }
+        if (static_cast<std::size_t>(instrument_id - base_id) >= table.size()) {
+            table.resize(static_cast<std::size_t>(instrument_id - base_id) + 1, -1);
+        }
+        int dense = static_cast<int>(ids.size());
+        table[instrument_id - base_id] = dense;
+        ids.push_back(instrument_id);
+        return dense;
+    }
+
+    // Dense index of instrument_id, or -1 if it was never registered
+    int index(int instrument_id) const {
+        unsigned offset = static_cast<unsigned>(instrument_id) - static_cast<unsigned>(base_id);
+        return offset < table.size() ? table[offset] : -1;
+    }
+
+    int id(int dense_index) const { return ids[dense_index]; }
+    int size() const { return static_cast<int>(ids.size()); }
+
+private:
+    int base_id = 0;
+    std::vector<int> table;  // id - base_id -> dense index or -1
+    std::vector<int> ids;    // dense index -> id
+};
+
+// Pads T to a whole number of cache lines so neighbouring array elements
+// never share one
+template <typename T>
+struct alignas(64) CacheAligned {
+    T value;
+};
+
+#endif
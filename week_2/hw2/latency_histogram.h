@@ -0,0 +1,151 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <string>
+
+// Fixed-size log-linear (HDR-style) histogram of nanosecond latencies.
+// Values below kLinear get one exact bucket each; above that every power of
+// two is split into kLinear / 2 equal sub-buckets, so any recorded value is
+// known to within 1 / (kLinear / 2) = 0.8% of itself, across the whole
+// uint64_t range. record() is a few integer ops and one increment, never
+// allocates, and histograms from different threads combine with merge().
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 8;
+    static constexpr std::uint64_t kLinear = 1ull << kSubBucketBits;
+    static constexpr std::uint64_t kHalf = kLinear / 2;
+    static constexpr std::size_t kBuckets = kLinear + (64 - kSubBucketBits) * kHalf;
+
+    void record(std::uint64_t ns) {
+        counts[bucketOf(ns)]++;
+        total++;
+        sum += static_cast<double>(ns);
+        min_ = std::min(min_, ns);
+        max_ = std::max(max_, ns);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            counts[i] += other.counts[i];
+        }
+        total += other.total;
+        sum += other.sum;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    std::uint64_t count() const { return total; }
+    std::uint64_t min() const { return total == 0 ? 0 : min_; }
+    std::uint64_t max() const { return max_; }
+    double mean() const { return total == 0 ? 0.0 : sum / static_cast<double>(total); }
+
+    // Smallest recorded-bucket upper bound with at least p percent of the
+    // values at or below it (capped at max()); p in [0, 100]
+    std::uint64_t percentile(double p) const {
+        if (total == 0) {
+            return 0;
+        }
+        std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total)));
+        rank = std::clamp<std::uint64_t>(rank, 1, total);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::min(bucketHigh(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    // Summary percentiles followed by the count in each power-of-two range
+    void print(std::ostream& out) const {
+        const std::ios::fmtflags flags = out.flags();
+        const std::streamsize precision = out.precision();
+        out << "  count " << total << ", mean " << static_cast<std::uint64_t>(mean()) << ", min " << min() << "\n";
+        const double points[] = {50.0, 90.0, 99.0, 99.9, 99.99};
+        for (double p : points) {
+            out << "  p" << std::left << std::setw(8) << p << std::right << std::setw(14) << percentile(p) << "\n";
+        }
+        out << "  " << std::left << std::setw(9) << "max" << std::right << std::setw(14) << max() << "\n";
+        if (total > 0) {
+            printDistribution(out);
+        }
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+private:
+    void printDistribution(std::ostream& out) const {
+        out << "  Distribution:\n";
+        std::uint64_t range_count = 0;
+        int range_bits = -1;
+        auto flush = [&]() {
+            if (range_count == 0) {
+                return;
+            }
+            std::uint64_t lo = range_bits <= 0 ? 0 : 1ull << (range_bits - 1);
+            std::uint64_t hi = range_bits >= 64 ? std::numeric_limits<std::uint64_t>::max() : (1ull << range_bits) - 1;
+            double share = 100.0 * static_cast<double>(range_count) / static_cast<double>(total);
+            out << "    [" << std::setw(12) << lo << ", " << std::setw(12) << hi << "] " << std::setw(10) << range_count
+                << "  " << std::fixed << std::setprecision(3) << std::setw(7) << share << "% "
+                << std::string(static_cast<std::size_t>(share / 2.0), '#') << "\n";
+        };
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            if (counts[i] == 0) {
+                continue;
+            }
+            int bits = std::bit_width(bucketLow(i));
+            if (bits != range_bits) {
+                flush();
+                range_bits = bits;
+                range_count = 0;
+            }
+            range_count += counts[i];
+        }
+        flush();
+    }
+
+    static std::size_t bucketOf(std::uint64_t v) {
+        if (v < kLinear) {
+            return static_cast<std::size_t>(v);
+        }
+        // Keep the top kSubBucketBits bits: mantissa in [kHalf, kLinear)
+        int shift = std::bit_width(v) - kSubBucketBits;
+        std::uint64_t mantissa = v >> shift;
+        return static_cast<std::size_t>(kLinear + (shift - 1) * kHalf + (mantissa - kHalf));
+    }
+
+    static std::uint64_t bucketLow(std::size_t i) {
+        if (i < kLinear) {
+            return i;
+        }
+        std::size_t k = i - kLinear;
+        int shift = static_cast<int>(k / kHalf) + 1;
+        return (kHalf + k % kHalf) << shift;
+    }
+
+    static std::uint64_t bucketHigh(std::size_t i) {
+        if (i < kLinear) {
+            return i;
+        }
+        std::size_t k = i - kLinear;
+        int shift = static_cast<int>(k / kHalf) + 1;
+        return bucketLow(i) + ((1ull << shift) - 1);
+    }
+
+    std::array<std::uint64_t, kBuckets> counts{};
+    std::uint64_t total = 0;
+    double sum = 0.0;
+    std::uint64_t min_ = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max_ = 0;
+};
+
+#endif
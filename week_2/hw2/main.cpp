@@ -4,6 +4,86 @@
 #include <vector>             
 #include <chrono>           
 #include <iostream>          
+#include <algorithm>
+#include <thread>
+#include <filesystem>
+#include <stdexcept>
+#include <array>
+#include <iomanip>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace {
+
+// The tick and order layouts before the hot/cold split, kept for comparison
+struct alignas(64) LegacyTick {
+    int instrument_id;
+    double price;
+    std::chrono::high_resolution_clock::time_point timestamp;
+};
+
+struct alignas(64) LegacyOrder {
+    int instrument_id;
+    double price;
+    bool is_buy;
+    std::chrono::high_resolution_clock::time_point timestamp;
+    SignalId signal;
+};
+
+// Sums prices and tracks the last timestamp per instrument: a pass over the
+// feed that touches every field, as replay and export do
+template <typename Tick, typename Price, typename Stamp>
+double scanTicks(const std::vector<Tick>& ticks, Price price_of, Stamp stamp_of, double& checksum) {
+    std::array<double, 16> sums{};
+    std::array<std::int64_t, 16> last{};
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const Tick& tick : ticks) {
+        sums[tick.instrument_id & 15] += price_of(tick);
+        last[tick.instrument_id & 15] = stamp_of(tick);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    checksum = 0;
+    for (int i = 0; i < 16; ++i) {
+        checksum += sums[i] + static_cast<double>(last[i]);
+    }
+    return std::chrono::duration<double>(end - start).count();
+}
+
+void benchmarkRecordLayouts(const std::vector<MarketData>& feed) {
+    std::vector<LegacyTick> legacy(feed.size());
+    for (std::size_t i = 0; i < feed.size(); ++i) {
+        legacy[i].instrument_id = feed[i].instrument_id;
+        legacy[i].price = feed[i].price();
+        legacy[i].timestamp = std::chrono::high_resolution_clock::time_point(std::chrono::nanoseconds(feed[i].timestamp_ns));
+    }
+
+    double legacy_checksum = 0;
+    double packed_checksum = 0;
+    double legacy_seconds = 1e30;
+    double packed_seconds = 1e30;
+    for (int rep = 0; rep < 5; ++rep) {
+        legacy_seconds = std::min(legacy_seconds, scanTicks(legacy, [](const LegacyTick& t) { return t.price; },
+            [](const LegacyTick& t) { return static_cast<std::int64_t>(t.timestamp.time_since_epoch().count()); },
+            legacy_checksum));
+        packed_seconds = std::min(packed_seconds, scanTicks(feed, [](const MarketData& t) { return t.price(); },
+            [](const MarketData& t) { return t.timestamp_ns; }, packed_checksum));
+    }
+
+    const double mb = 1.0 / (1024.0 * 1024.0);
+    std::cout << "\nRecord layouts (" << feed.size() << " ticks, checksums " << (std::abs(legacy_checksum - packed_checksum) < 1e-3 * std::abs(legacy_checksum) ? "agree" : "DIFFER") << "):\n"
+              << std::right << std::fixed << std::setprecision(1)
+              << "  tick   alignas(64): " << std::setw(3) << sizeof(LegacyTick) << " B, " << std::setw(7) << feed.size() * sizeof(LegacyTick) * mb
+              << " MB, scan " << std::setw(7) << feed.size() / legacy_seconds / 1e6 << " M ticks/sec\n"
+              << "  tick   packed:      " << std::setw(3) << sizeof(MarketData) << " B, " << std::setw(7) << feed.size() * sizeof(MarketData) * mb
+              << " MB, scan " << std::setw(7) << feed.size() / packed_seconds / 1e6 << " M ticks/sec\n"
+              << "  order  alignas(64): " << std::setw(3) << sizeof(LegacyOrder) << " B\n"
+              << "  order  hot + cold:  " << std::setw(3) << sizeof(Order) << " B + " << sizeof(OrderDetails) << " B" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout.precision(6);
+}
+
+} // namespace
 
 int main() {
     std::vector<MarketData> market_feed_data;
@@ -29,11 +109,104 @@ int main() {
     auto end_process = std::chrono::high_resolution_clock::now();
     auto process_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_process - start_process).count();
     std::cout << "Trade processing took: " << process_time << " ms" << std::endl;
+    double process_seconds = std::chrono::duration<double>(end_process - start_process).count();
+    std::cout << "Throughput (ticks/sec):   " << static_cast<long long>(market_feed_data.size() / process_seconds) << std::endl;
 
     engine.reportStats();
 
     auto total_runtime = std::chrono::duration_cast<std::chrono::milliseconds>(end_process - start_gen).count();
     std::cout << "Total Runtime (ms):       " << total_runtime << std::endl;
 
+    // Same feed with instruments sharded across threads
+    TradeEngine sharded_engine(market_feed_data);
+    auto start_parallel = std::chrono::high_resolution_clock::now();
+    sharded_engine.processParallel();
+    auto end_parallel = std::chrono::high_resolution_clock::now();
+    double parallel_seconds = std::chrono::duration<double>(end_parallel - start_parallel).count();
+    std::cout << "\nSharded processing (" << std::max(1u, std::thread::hardware_concurrency()) << " threads) took: "
+              << static_cast<long long>(parallel_seconds * 1000) << " ms" << std::endl;
+    std::cout << "Throughput (ticks/sec):   " << static_cast<long long>(market_feed_data.size() / parallel_seconds) << std::endl;
+    sharded_engine.reportStats();
+
+    // Round-trip the feed through the columnar format and replay it from the
+    // memory mapping
+    try {
+        const auto dir = std::filesystem::temp_directory_path();
+        const std::string raw_path = (dir / "hw2_ticks.col").string();
+        const std::string packed_path = (dir / "hw2_ticks_packed.col").string();
+        engine.exportTickData(raw_path);
+        engine.exportTickData(packed_path, true);
+        const std::string orders_path = (dir / "hw2_orders.col").string();
+        engine.exportOrderHistory(orders_path, true);
+
+        std::cout << "\nColumnar tick file:       " << std::filesystem::file_size(raw_path) << " bytes ("
+                  << std::filesystem::file_size(packed_path) << " compressed)" << std::endl;
+        std::cout << "Columnar order file:      " << std::filesystem::file_size(orders_path) << " bytes (compressed)" << std::endl;
+
+        // Replays run in event time from a fixed seed, so both files must
+        // produce byte-identical order exports
+        const std::uint64_t replay_seed = 42;
+        std::vector<std::string> replay_orders;
+        for (const std::string& path : {raw_path, packed_path}) {
+            auto start_replay = std::chrono::high_resolution_clock::now();
+            ColumnarFile file(path);
+            std::vector<MarketData> no_feed;
+            TradeEngine replay_engine(no_feed, replay_seed);
+            replay_engine.replay(file.ticks());
+            auto end_replay = std::chrono::high_resolution_clock::now();
+            double replay_seconds = std::chrono::duration<double>(end_replay - start_replay).count();
+            std::cout << "Replay from " << (file.compressed() ? "compressed" : "raw") << " file took: "
+                      << static_cast<long long>(replay_seconds * 1000) << " ms, "
+                      << static_cast<long long>(file.rows() / replay_seconds) << " ticks/sec" << std::endl;
+
+            const std::string replay_path = (dir / "hw2_replay_orders.col").string();
+            replay_engine.exportOrderHistory(replay_path);
+            std::ifstream in(replay_path, std::ios::binary);
+            replay_orders.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            std::filesystem::remove(replay_path);
+        }
+        bool reproducible = replay_orders[0] == replay_orders[1];
+        std::cout << "Replayed order exports:   " << replay_orders[0].size() << " bytes, "
+                  << (reproducible ? "identical" : "DIFFERENT") << " across replays" << std::endl;
+        if (!reproducible) {
+            return 1;
+        }
+        std::filesystem::remove(raw_path);
+        std::filesystem::remove(packed_path);
+        std::filesystem::remove(orders_path);
+    } catch (const std::exception& e) {
+        std::cerr << "Columnar export/replay failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // Seeded synthetic feed: reproducible bit for bit whatever the thread count
+    {
+        const std::size_t synthetic_ticks = 2000000;
+        FeedConfig config;
+        config.jump_probability = 0.001;
+        config.threads = 0;
+        std::vector<MarketData> synthetic;
+        MarketDataFeed synthetic_generator(synthetic);
+        auto start_synthetic = std::chrono::high_resolution_clock::now();
+        synthetic_generator.generateDeterministic(synthetic_ticks, config);
+        auto end_synthetic = std::chrono::high_resolution_clock::now();
+        double synthetic_seconds = std::chrono::duration<double>(end_synthetic - start_synthetic).count();
+
+        std::vector<MarketData> single_threaded;
+        config.threads = 1;
+        MarketDataFeed(single_threaded).generateDeterministic(synthetic_ticks, config);
+        bool identical = std::equal(synthetic.begin(), synthetic.end(), single_threaded.begin(),
+                                    [](const MarketData& a, const MarketData& b) {
+                                        return a.instrument_id == b.instrument_id && a.price_ticks == b.price_ticks &&
+                                               a.timestamp_ns == b.timestamp_ns;
+                                    });
+        std::cout << "\nDeterministic generation of " << synthetic_ticks << " ticks took: "
+                  << static_cast<long long>(synthetic_seconds * 1000) << " ms, "
+                  << static_cast<long long>(synthetic_ticks / synthetic_seconds) << " ticks/sec ("
+                  << (identical ? "matches" : "DIFFERS FROM") << " single-threaded run)" << std::endl;
+
+        benchmarkRecordLayouts(synthetic);
+    }
+
     return 0; 
 }
\ No newline at end of file
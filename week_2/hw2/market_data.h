@@ -2,11 +2,36 @@
 #define MARKET_DATA_H
 
 #include <chrono>
+#include <cmath>
+#include <cstdint>
 
-struct alignas(64) MarketData {
-    int instrument_id;
-    double price;
-    std::chrono::high_resolution_clock::time_point timestamp;
+// Prices are carried as whole ticks of kPriceTick
+constexpr double kPriceTick = 0.01;
+
+inline std::int32_t toPriceTicks(double price) {
+    return static_cast<std::int32_t>(std::llround(price / kPriceTick));
+}
+
+inline double fromPriceTicks(std::int32_t ticks) {
+    return ticks * kPriceTick;
+}
+
+// Nanoseconds since the high_resolution_clock epoch
+inline std::int64_t clockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+// Packed 16-byte tick: four per cache line, trivially copyable, and the
+// same fields the columnar tick files store
+struct MarketData {
+    std::int64_t timestamp_ns;
+    std::int32_t price_ticks;
+    std::int32_t instrument_id;
+
+    double price() const { return fromPriceTicks(price_ticks); }
 };
 
-#endif 
\ No newline at end of file
+static_assert(sizeof(MarketData) == 16);
+
+#endif
@@ -2,6 +2,11 @@
 #include <vector>
 #include <random> 
 #include <chrono> 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
 using std::vector;
 
 MarketDataFeed::MarketDataFeed(vector<MarketData>& ref) : data(ref) {}
@@ -15,8 +20,187 @@ void MarketDataFeed::generateData(int num_ticks) {
     for (int i = 0; i < num_ticks; ++i) {
         MarketData md;
         md.instrument_id = i % 10; 
-        md.price = price_dist(gen); 
-        md.timestamp = std::chrono::high_resolution_clock::now(); 
+        md.price_ticks = toPriceTicks(price_dist(gen)); 
+        md.timestamp_ns = clockNs(); 
         data.push_back(md); 
     }
-}
\ No newline at end of file
+}
+
+namespace {
+
+// The feed is cut into fixed-size chunks whatever the thread count, so the
+// floating-point work (and therefore the output) never depends on it
+constexpr std::size_t kChunkTicks = 1 << 16;
+// Ticks whose random draws are computed together in a branch-free loop
+constexpr std::size_t kBatchTicks = 256;
+constexpr std::uint64_t kJumpStream = 0x6a09e667f3bcc909ull;
+
+// SplitMix64 output function applied to key + counter * gamma: a
+// counter-based generator, so tick i's random bits are a pure function of
+// (seed, i) and any tick range can be drawn independently
+inline std::uint64_t counterHash(std::uint64_t key, std::uint64_t counter) {
+    std::uint64_t z = key + counter * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+constexpr double kTwoPow32 = 4294967296.0;
+
+// Per-tick innovations of ticks [first, first + count), count <= kBatchTicks.
+// Noise is the difference of two uniforms (triangular, variance 1/6) scaled
+// to the configured volatility: cheap, bounded and close enough to normal
+// for test data.
+void drawInnovations(const FeedConfig& config, std::uint64_t first, std::size_t count, double* innovations) {
+    const double noise_scale = config.volatility * std::sqrt(6.0) / kTwoPow32;
+    for (std::size_t j = 0; j < count; ++j) {
+        std::uint64_t h = counterHash(config.seed, first + j);
+        double u1 = static_cast<double>(static_cast<std::uint32_t>(h));
+        double u2 = static_cast<double>(static_cast<std::uint32_t>(h >> 32));
+        innovations[j] = (u1 - u2) * noise_scale;
+    }
+    if (config.jump_probability <= 0.0) {
+        return;
+    }
+    const double threshold = config.jump_probability * kTwoPow32;
+    for (std::size_t j = 0; j < count; ++j) {
+        std::uint64_t h = counterHash(config.seed ^ kJumpStream, first + j);
+        double draw = static_cast<double>(static_cast<std::uint32_t>(h));
+        double sign = (h >> 32) & 1 ? 1.0 : -1.0;
+        double size = config.jump_size * (0.5 + static_cast<double>(h >> 33) / (kTwoPow32 / 2.0));
+        innovations[j] += draw < threshold ? sign * size : 0.0;
+    }
+}
+
+std::int64_t syntheticTime(const FeedConfig& config, std::uint64_t tick) {
+    return config.start_ns + static_cast<std::int64_t>(tick) * config.interval_ns;
+}
+
+// Every stateful process is the affine step price' = a * price + c + noise
+struct Step {
+    double a;
+    double c;
+};
+
+Step stepOf(const FeedConfig& config) {
+    if (config.process == PriceProcess::MeanReverting) {
+        return {1.0 - config.reversion, config.reversion * config.start_price};
+    }
+    return {1.0, 0.0};
+}
+
+// Runs ticks [first, first + count) from the per-instrument prices in
+// state, leaving the end prices there. gain (if given) is multiplied by a
+// once per step of each instrument; out (if given) receives the ticks.
+void runChunk(const FeedConfig& config, std::uint64_t first, std::size_t count, double* state, double* gain,
+              MarketData* out) {
+    const Step step = stepOf(config);
+    const std::size_t instruments = static_cast<std::size_t>(config.num_instruments);
+    std::size_t instrument = static_cast<std::size_t>(first % instruments);
+    double innovations[kBatchTicks];
+
+    for (std::size_t done = 0; done < count; done += kBatchTicks) {
+        const std::size_t batch = std::min(kBatchTicks, count - done);
+        drawInnovations(config, first + done, batch, innovations);
+        for (std::size_t j = 0; j < batch; ++j) {
+            double price = step.a * state[instrument] + step.c + innovations[j];
+            state[instrument] = price;
+            if (gain) {
+                gain[instrument] *= step.a;
+            }
+            if (out) {
+                MarketData& md = out[done + j];
+                md.instrument_id = static_cast<int>(instrument);
+                md.timestamp_ns = syntheticTime(config, first + done + j);
+                md.price_ticks = toPriceTicks(std::max(price, config.min_price));
+            }
+            if (++instrument == instruments) {
+                instrument = 0;
+            }
+        }
+    }
+}
+
+void fillUniform(const FeedConfig& config, std::uint64_t first, std::size_t count, MarketData* out) {
+    const std::uint64_t instruments = static_cast<std::uint64_t>(config.num_instruments);
+    const double range = (config.max_price - config.min_price) / 9007199254740992.0;  // 2^53
+    for (std::size_t j = 0; j < count; ++j) {
+        std::uint64_t h = counterHash(config.seed, first + j);
+        out[j].instrument_id = static_cast<int>((first + j) % instruments);
+        out[j].timestamp_ns = syntheticTime(config, first + j);
+        out[j].price_ticks = toPriceTicks(config.min_price + static_cast<double>(h >> 11) * range);
+    }
+}
+
+// Calls fn(i) for every i in [0, count) from `threads` threads
+template <typename Fn>
+void parallelFor(std::size_t count, unsigned threads, const Fn& fn) {
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+void MarketDataFeed::generateDeterministic(std::size_t num_ticks, const FeedConfig& config) {
+    if (config.num_instruments <= 0) {
+        throw std::invalid_argument("FeedConfig::num_instruments must be positive.");
+    }
+    if (config.interval_ns < 0) {
+        throw std::invalid_argument("FeedConfig::interval_ns must not be negative.");
+    }
+
+    const std::size_t base = data.size();
+    data.resize(base + num_ticks);
+    MarketData* out = data.data() + base;
+
+    const std::size_t chunks = (num_ticks + kChunkTicks - 1) / kChunkTicks;
+    unsigned threads = config.threads != 0 ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(chunks, 1)));
+    auto chunk_size = [&](std::size_t chunk) { return std::min(kChunkTicks, num_ticks - chunk * kChunkTicks); };
+
+    if (config.process == PriceProcess::Uniform) {
+        parallelFor(chunks, threads, [&](std::size_t chunk) {
+            fillUniform(config, chunk * kChunkTicks, chunk_size(chunk), out + chunk * kChunkTicks);
+        });
+        return;
+    }
+
+    // A chunk maps each instrument's entry price p to gain * p + offset.
+    // Pass 1 finds every chunk's map in parallel (running it from p = 0),
+    // a short sequential scan turns them into entry prices, and pass 2
+    // regenerates each chunk from its entry prices in parallel.
+    const std::size_t instruments = static_cast<std::size_t>(config.num_instruments);
+    std::vector<double> offsets(chunks * instruments, 0.0);
+    std::vector<double> gains(chunks * instruments, 1.0);
+    parallelFor(chunks, threads, [&](std::size_t chunk) {
+        runChunk(config, chunk * kChunkTicks, chunk_size(chunk), &offsets[chunk * instruments],
+                 &gains[chunk * instruments], nullptr);
+    });
+
+    std::vector<double> price(instruments, config.start_price);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        for (std::size_t k = 0; k < instruments; ++k) {
+            double& slot = offsets[chunk * instruments + k];
+            double exit_price = gains[chunk * instruments + k] * price[k] + slot;
+            slot = price[k];  // now the chunk's entry price
+            price[k] = exit_price;
+        }
+    }
+
+    parallelFor(chunks, threads, [&](std::size_t chunk) {
+        runChunk(config, chunk * kChunkTicks, chunk_size(chunk), &offsets[chunk * instruments], nullptr,
+                 out + chunk * kChunkTicks);
+    });
+}
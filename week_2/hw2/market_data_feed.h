@@ -2,16 +2,46 @@
 #define MARKET_DATA_FEED_H
 
 #include "market_data.h" 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <chrono> 
 using std::vector;
 
+// How a synthetic instrument's price moves from tick to tick
+enum class PriceProcess {
+    Uniform,        // independent draws in [min_price, max_price]
+    RandomWalk,     // price += noise
+    MeanReverting   // price += theta * (start_price - price) + noise
+};
+
+struct FeedConfig {
+    std::uint64_t seed = 42;
+    int num_instruments = 10;       // tick i belongs to instrument i % num_instruments
+    PriceProcess process = PriceProcess::MeanReverting;
+    double start_price = 150.0;     // also the mean-reversion level
+    double min_price = 100.0;       // Uniform range; other processes are floored at min_price
+    double max_price = 200.0;
+    double volatility = 0.5;        // standard deviation of the per-tick noise
+    double reversion = 0.01;        // theta, the fraction of the gap closed per tick
+    double jump_probability = 0.0;  // chance per tick of an extra jump
+    double jump_size = 5.0;         // jumps are +/- jump_size * [0.5, 1.5)
+    std::int64_t start_ns = 0;      // first timestamp, ns since the clock's epoch
+    std::int64_t interval_ns = 1000;
+    unsigned threads = 1;           // 0 = hardware concurrency
+};
+
 class MarketDataFeed {
 public:
     MarketDataFeed(vector<MarketData>& ref);
 
     void generateData(int num_ticks);
 
+    // Appends num_ticks synthetic ticks that depend only on config (not on
+    // the thread count or the wall clock): the same seed always yields the
+    // same feed, bit for bit, with timestamps start_ns + i * interval_ns.
+    void generateDeterministic(std::size_t num_ticks, const FeedConfig& config = {});
+
 private:
     vector<MarketData>& data;
 };
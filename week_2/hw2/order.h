@@ -1,15 +1,26 @@
 #ifndef ORDER_H
 #define ORDER_H
 
-#include <chrono>
-#include <string>
+#include "signals.h"
+#include <cstdint>
 
-struct alignas(64) Order {
-    int instrument_id;
-    double price;
+// Hot part of an order: what the order path writes and exports scan for
+// every order. Plain 24-byte POD, so the order log is a flat array.
+struct Order {
+    std::int64_t timestamp_ns;
+    std::int32_t instrument_id;
+    std::int32_t price_ticks;
     bool is_buy;
-    std::chrono::high_resolution_clock::time_point timestamp;
-    std::string signal_source;
+
+    double price() const { return fromPriceTicks(price_ticks); }
+};
+
+static_assert(sizeof(Order) == 24);
+
+// Cold part of an order, only read by reports: kept in a side table with
+// the same index as the order
+struct OrderDetails {
+    SignalId signal;
 };
 
-#endif
\ No newline at end of file
+#endif
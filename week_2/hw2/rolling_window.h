@@ -0,0 +1,134 @@
+#ifndef ROLLING_WINDOW_H
+#define ROLLING_WINDOW_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// Fixed-capacity ring buffer: once full, each push overwrites the oldest
+// element. Storage is inline, so pushing never allocates.
+template <typename T, std::size_t Capacity>
+class RingBuffer {
+    static_assert(Capacity > 0, "RingBuffer capacity must be positive");
+
+public:
+    // Returns the element that was evicted (only meaningful when full() was
+    // true before the push)
+    T push(const T& value) {
+        T evicted = buffer[head];
+        buffer[head] = value;
+        head = head + 1 == Capacity ? 0 : head + 1;
+        if (count < Capacity) {
+            ++count;
+        }
+        return evicted;
+    }
+
+    // ago = 0 is the newest element, ago = size() - 1 the oldest
+    const T& back(std::size_t ago = 0) const {
+        std::size_t index = head + Capacity - 1 - ago;
+        return buffer[index >= Capacity ? index - Capacity : index];
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == Capacity; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    std::array<T, Capacity> buffer{};
+    std::size_t head = 0;  // next slot to write
+    std::size_t count = 0;
+};
+
+// Rolling window over the last Capacity prices with O(1) mean, variance,
+// min and max. Mean and variance follow Welford's update (add while filling,
+// replace once full), which stays accurate over millions of pushes where a
+// running sum / sum of squares would drift. Min and max use monotonic queues
+// of (sequence, price) pairs: amortised O(1) per push, each price enters and
+// leaves each queue once.
+template <std::size_t Capacity>
+class RollingWindow {
+public:
+    void push(double price) {
+        const std::size_t seq = pushed++;
+        if (values.full()) {
+            const double old = values.push(price);
+            const double old_mean = mean_;
+            mean_ += (price - old) / Capacity;
+            m2 += (price - old) * (price - mean_ + old - old_mean);
+            if (m2 < 0.0) {
+                m2 = 0.0;
+            }
+        } else {
+            values.push(price);
+            const double delta = price - mean_;
+            mean_ += delta / values.size();
+            m2 += delta * (price - mean_);
+        }
+        min_queue.push(seq, price, [](double kept, double v) { return kept < v; });
+        max_queue.push(seq, price, [](double kept, double v) { return kept > v; });
+    }
+
+    std::size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    bool full() const { return values.full(); }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    // ago = 0 is the latest price
+    double back(std::size_t ago = 0) const { return values.back(ago); }
+
+    double sum() const { return mean_ * values.size(); }
+    double mean() const { return mean_; }
+    // Population variance of the window (0 when fewer than two prices)
+    double variance() const { return values.size() > 1 ? m2 / values.size() : 0.0; }
+    double stddev() const { return std::sqrt(variance()); }
+    double min() const { return min_queue.front(); }
+    double max() const { return max_queue.front(); }
+
+private:
+    // Candidates for the window extreme, oldest first; values are strictly
+    // "better" (smaller for min, larger for max) towards the front
+    class MonotonicQueue {
+    public:
+        template <typename Keep>
+        void push(std::size_t seq, double value, Keep keep) {
+            // Drop the front once it slides out of the window, so the new
+            // entry always has a free slot
+            if (length > 0 && seq - at(0).seq >= Capacity) {
+                start = start + 1 == Capacity ? 0 : start + 1;
+                --length;
+            }
+            while (length > 0 && !keep(at(length - 1).value, value)) {
+                --length;
+            }
+            at(length++) = {seq, value};
+        }
+
+        double front() const { return length > 0 ? slots[start].value : 0.0; }
+
+    private:
+        struct Entry {
+            std::size_t seq;
+            double value;
+        };
+
+        Entry& at(std::size_t i) {
+            std::size_t index = start + i;
+            return slots[index >= Capacity ? index - Capacity : index];
+        }
+
+        std::array<Entry, Capacity> slots{};
+        std::size_t start = 0;
+        std::size_t length = 0;
+    };
+
+    RingBuffer<double, Capacity> values;
+    double mean_ = 0.0;
+    double m2 = 0.0;
+    std::size_t pushed = 0;
+    MonotonicQueue min_queue;
+    MonotonicQueue max_queue;
+};
+
+#endif
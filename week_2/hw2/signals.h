@@ -0,0 +1,100 @@
+#ifndef SIGNALS_H
+#define SIGNALS_H
+
+#include "market_data.h"
+#include <cstdint>
+
+// Identifies which signal an order is attributed to. Declared in the order
+// the per-signal breakdown is printed.
+enum class SignalId : std::uint8_t {
+    HighThreshold,
+    LowThreshold,
+    AboveAvg,
+    BelowAvg,
+    Momentum,
+    Count
+};
+
+constexpr int kSignalCount = static_cast<int>(SignalId::Count);
+
+inline const char* signalName(SignalId id) {
+    switch (id) {
+        case SignalId::HighThreshold: return "Signal 1 (High Threshold)";
+        case SignalId::LowThreshold: return "Signal 1 (Low Threshold)";
+        case SignalId::AboveAvg: return "Signal 2 (Above Avg)";
+        case SignalId::BelowAvg: return "Signal 2 (Below Avg)";
+        case SignalId::Momentum: return "Signal 3 (Momentum)";
+        default: return "Unknown";
+    }
+}
+
+// One bit per SignalId on each side; a signal sets at most one bit per tick
+struct SignalVotes {
+    std::uint32_t buy = 0;
+    std::uint32_t sell = 0;
+
+    static constexpr std::uint32_t bit(SignalId id) { return 1u << static_cast<int>(id); }
+};
+
+// Signal policies: vote(tick, history, votes) reads the tick and the
+// instrument's rolling price window (which already includes the tick) and
+// sets its bits in votes.
+
+// Signal 1: Price thresholds
+struct ThresholdSignal {
+    template <typename Window>
+    static void vote(const MarketData& tick, const Window&, SignalVotes& votes) {
+        if (tick.price() < 105.0) {
+            votes.buy |= SignalVotes::bit(SignalId::LowThreshold);
+        } else if (tick.price() > 195.0) {
+            votes.sell |= SignalVotes::bit(SignalId::HighThreshold);
+        }
+    }
+};
+
+// Signal 2: Deviation from average
+struct MeanDeviationSignal {
+    template <typename Window>
+    static void vote(const MarketData& tick, const Window& history, SignalVotes& votes) {
+        if (history.size() < 5) {
+            return;
+        }
+        double avg = history.mean();
+        if (avg <= 0) return;
+
+        if (tick.price() < avg * 0.98) {
+            votes.buy |= SignalVotes::bit(SignalId::BelowAvg);
+        } else if (tick.price() > avg * 1.02) {
+            votes.sell |= SignalVotes::bit(SignalId::AboveAvg);
+        }
+    }
+};
+
+// Signal 3: Simple momentum
+struct MomentumSignal {
+    template <typename Window>
+    static void vote(const MarketData& tick, const Window& history, SignalVotes& votes) {
+        if (history.size() < 3) {
+            return;
+        }
+        double price_t_minus_1 = history.back(1);
+        double price_t_minus_2 = history.back(2);
+        if (price_t_minus_1 > price_t_minus_2 && tick.price() > price_t_minus_1) {
+            votes.buy |= SignalVotes::bit(SignalId::Momentum);
+        }
+    }
+};
+
+// Compile-time list of signal policies, evaluated in order with no virtual
+// calls or allocation
+template <typename... Signals>
+struct SignalSet {
+    template <typename Window>
+    static SignalVotes evaluate(const MarketData& tick, const Window& history) {
+        SignalVotes votes;
+        (Signals::vote(tick, history, votes), ...);
+        return votes;
+    }
+};
+
+#endif
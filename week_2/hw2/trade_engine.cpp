@@ -3,194 +3,297 @@
 #include <numeric>
 #include <iostream>
 #include <algorithm>
-#include <unordered_map>
 #include <fstream>   
 #include <iomanip>   
 #include <sstream>  
-#include <map>       
+#include <array>
+#include <bit>
 #include <ctime>     
 #include <random> 
 #include <chrono>
+#include <thread>
 
 TradeEngine::TradeEngine(const std::vector<MarketData>& feed)
+    : TradeEngine(feed, static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count())) {}
+
+TradeEngine::TradeEngine(const std::vector<MarketData>& feed, std::uint64_t seed)
     : market_data(feed) {
-    auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-    random_generator.seed(seed);
+    std::seed_seq seq{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+    random_generator.seed(seq);
+
+    // Every instrument in the feed gets its dense slot before the first tick
+    for (const auto& tick : market_data) {
+        registerInstrument(tick.instrument_id);
+    }
+}
+
+int TradeEngine::registerInstrument(int instrument_id) {
+    int index = instruments.add(instrument_id);
+    if (index >= static_cast<int>(price_windows.size())) {
+        price_windows.resize(index + 1);
+        timestamp_windows.resize(index + 1);
+    }
+    return index;
 }
 
 void TradeEngine::process() {
+    // At most one order per tick, so the loop below never reallocates
+    orders.reserve(orders.size() + market_data.size());
+    order_details.reserve(order_details.size() + market_data.size());
+
     for (const auto& tick : market_data) {
-        updateHistory(tick);
-
-        int buy_votes = 0;
-        int sell_votes = 0;
-        std::vector<std::string> contributing_buy_signals;
-        std::vector<std::string> contributing_sell_signals;
-
-        // 1: Evaluate all signals and count votes
-        SignalAction action1 = evaluateSignal1(tick);
-        if (action1 == SignalAction::BUY) {
-            buy_votes++;
-            contributing_buy_signals.push_back("Signal 1 (Low Threshold)");
-        } else if (action1 == SignalAction::SELL) {
-            sell_votes++;
-            contributing_sell_signals.push_back("Signal 1 (High Threshold)");
+        int index = instruments.index(tick.instrument_id);
+        if (index < 0) {
+            index = registerInstrument(tick.instrument_id);
         }
+        processTick(tick, index, orders, order_details, latencies, random_generator);
+    } 
+    ticks_processed += market_data.size();
+}
 
-        SignalAction action2 = evaluateSignal2(tick);
-        if (action2 == SignalAction::BUY) {
-            buy_votes++;
-            contributing_buy_signals.push_back("Signal 2 (Below Avg)");
-        } else if (action2 == SignalAction::SELL) {
-            sell_votes++;
-            contributing_sell_signals.push_back("Signal 2 (Above Avg)");
+void TradeEngine::replay(const TickColumns& ticks) {
+    orders.reserve(orders.size() + ticks.size);
+    order_details.reserve(order_details.size() + ticks.size);
+
+    for (std::size_t i = 0; i < ticks.size; ++i) {
+        MarketData tick;
+        tick.timestamp_ns = ticks.timestamp_ns[i];
+        tick.price_ticks = ticks.price_ticks[i];
+        tick.instrument_id = ticks.instrument_id[i];
+        int index = instruments.index(tick.instrument_id);
+        if (index < 0) {
+            index = registerInstrument(tick.instrument_id);
         }
+        processTick(tick, index, orders, order_details, latencies, random_generator, true);
+    }
+    ticks_processed += ticks.size;
+}
+
+void TradeEngine::processParallel(unsigned num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_threads = std::min<unsigned>(num_threads, instruments.size());
+    if (num_threads <= 1) {
+        process();
+        return;
+    }
 
-        SignalAction action3 = evaluateSignal3(tick);
-        if (action3 == SignalAction::BUY) {
-            buy_votes++;
-            contributing_buy_signals.push_back("Signal 3 (Momentum)");
+    // Instruments go to shards heaviest first, each to the currently lightest
+    // shard, so shards get similar tick counts
+    std::vector<std::size_t> ticks_per_instrument(instruments.size(), 0);
+    for (const auto& tick : market_data) {
+        int index = instruments.index(tick.instrument_id);
+        if (index < 0) {
+            index = registerInstrument(tick.instrument_id);
+            ticks_per_instrument.resize(instruments.size(), 0);
         }
+        ticks_per_instrument[index]++;
+    }
+    std::vector<int> by_load(instruments.size());
+    std::iota(by_load.begin(), by_load.end(), 0);
+    std::sort(by_load.begin(), by_load.end(), [&](int a, int b) { return ticks_per_instrument[a] > ticks_per_instrument[b]; });
+    std::vector<unsigned> shard_of(instruments.size());
+    std::vector<std::size_t> shard_load(num_threads, 0);
+    for (int index : by_load) {
+        unsigned lightest = static_cast<unsigned>(std::min_element(shard_load.begin(), shard_load.end()) - shard_load.begin());
+        shard_of[index] = lightest;
+        shard_load[lightest] += ticks_per_instrument[index];
+    }
+
+    // Each shard owns its instruments' windows (distinct cache lines), its
+    // own bucket of ticks and its own output buffers and RNG, so workers
+    // share nothing writable. Shards are cache-line aligned so one shard's
+    // RNG state never sits on a line with the next shard's vector headers.
+    struct alignas(64) Shard {
+        std::vector<MarketData> ticks;
+        std::vector<Order> orders;
+        std::vector<OrderDetails> details;
+        LatencyHistogram latencies;
+        std::mt19937 rng;
+    };
+    std::vector<Shard> shards(num_threads);
+    for (unsigned s = 0; s < num_threads; ++s) {
+        shards[s].ticks.reserve(shard_load[s]);
+        shards[s].orders.reserve(shard_load[s]);
+        shards[s].details.reserve(shard_load[s]);
+        shards[s].rng.seed(random_generator());
+    }
 
-        // 2: Apply Voting Consensus
-        if (buy_votes > sell_votes) {
-            // Consensus is BUY: Place one BUY order
-            std::string selected_signal;
-            // Choose one of the contributing buy signals randomly for attribution
-            if (contributing_buy_signals.size() == 1) {
-                selected_signal = contributing_buy_signals[0];
-            } else {
-                std::uniform_int_distribution<> distrib(0, contributing_buy_signals.size() - 1);
-                selected_signal = contributing_buy_signals[distrib(random_generator)];
+    // One pass buckets the feed by shard, keeping feed order within each
+    // bucket; workers then stream only their own ticks instead of every
+    // worker scanning (and filtering) the whole feed
+    for (const auto& tick : market_data) {
+        shards[shard_of[instruments.index(tick.instrument_id)]].ticks.push_back(tick);
+    }
+
+    auto run_shard = [&](unsigned s) {
+        Shard& shard = shards[s];
+        for (const auto& tick : shard.ticks) {
+            processTick(tick, instruments.index(tick.instrument_id), shard.orders, shard.details, shard.latencies, shard.rng);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned s = 1; s < num_threads; ++s) {
+        workers.emplace_back(run_shard, s);
+    }
+    run_shard(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Each shard's orders are already in timestamp order: k-way merge them
+    std::size_t total = 0;
+    for (const Shard& shard : shards) {
+        total += shard.orders.size();
+    }
+    orders.reserve(orders.size() + total);
+    order_details.reserve(order_details.size() + total);
+    std::vector<std::size_t> next(num_threads, 0);
+    for (std::size_t n = 0; n < total; ++n) {
+        unsigned earliest = num_threads;
+        for (unsigned s = 0; s < num_threads; ++s) {
+            if (next[s] == shards[s].orders.size()) {
+                continue;
             }
-            placeOrder(tick, true, selected_signal); 
-
-        } else if (sell_votes > buy_votes) {
-            // Consensus is SELL: Place one SELL order
-            std::string selected_signal;
-            // Choose one of the contributing sell signals randomly for attribution
-             if (contributing_sell_signals.size() == 1) {
-                selected_signal = contributing_sell_signals[0];
-            } else {
-                std::uniform_int_distribution<> distrib(0, contributing_sell_signals.size() - 1);
-                selected_signal = contributing_sell_signals[distrib(random_generator)];
+            if (earliest == num_threads ||
+                shards[s].orders[next[s]].timestamp_ns < shards[earliest].orders[next[earliest]].timestamp_ns) {
+                earliest = s;
             }
-            placeOrder(tick, false, selected_signal); 
-
         }
-    } 
+        orders.push_back(shards[earliest].orders[next[earliest]]);
+        order_details.push_back(shards[earliest].details[next[earliest]]);
+        ++next[earliest];
+    }
+    for (const Shard& shard : shards) {
+        latencies.merge(shard.latencies);
+    }
+    ticks_processed += market_data.size();
+}
+
+void TradeEngine::processTick(const MarketData& tick, int index, std::vector<Order>& out_orders,
+                              std::vector<OrderDetails>& out_details, LatencyHistogram& out_latencies, std::mt19937& rng,
+                              bool event_time) {
+    updateHistory(tick, index);
+    const PriceWindow& history = price_windows[index].value;
+
+    // 1: Evaluate all signals; each contributing signal sets its bit
+    SignalVotes votes = ActiveSignals::evaluate(tick, history);
+    int buy_votes = std::popcount(votes.buy);
+    int sell_votes = std::popcount(votes.sell);
+
+    // 2: Apply Voting Consensus, attributing the order to one of the
+    // contributing signals chosen at random
+    if (buy_votes > sell_votes) {
+        placeOrder(tick, true, pickSignal(votes.buy, buy_votes, rng), out_orders, out_details, out_latencies, event_time);
+    } else if (sell_votes > buy_votes) {
+        placeOrder(tick, false, pickSignal(votes.sell, sell_votes, rng), out_orders, out_details, out_latencies, event_time);
+    }
+}
+
+SignalId TradeEngine::pickSignal(std::uint32_t mask, int count, std::mt19937& rng) {
+    int skip = 0;
+    if (count > 1) {
+        std::uniform_int_distribution<> distrib(0, count - 1);
+        skip = distrib(rng);
+    }
+    for (; skip > 0; --skip) {
+        mask &= mask - 1;  // clear the lowest set bit
+    }
+    return static_cast<SignalId>(std::countr_zero(mask));
 }
 
-void TradeEngine::placeOrder(const MarketData& tick, bool is_buy, const std::string& signal_name) {
-    auto now = std::chrono::high_resolution_clock::now(); 
+void TradeEngine::placeOrder(const MarketData& tick, bool is_buy, SignalId signal, std::vector<Order>& out_orders,
+                             std::vector<OrderDetails>& out_details, LatencyHistogram& out_latencies, bool event_time) {
+    std::int64_t now = event_time ? tick.timestamp_ns : clockNs();
     Order order {
-        tick.instrument_id,
-        tick.price + (is_buy ? 0.01 : -0.01), 
-        is_buy,
         now,
-        signal_name 
+        tick.instrument_id,
+        tick.price_ticks + (is_buy ? 1 : -1),  // one price tick through the market
+        is_buy
     };
-    orders.push_back(order);
+    out_orders.push_back(order);
+    out_details.push_back(OrderDetails{signal});
+    if (event_time) {
+        return;
+    }
 
-    auto latency_ns = std::chrono::duration_cast<std::chrono::milliseconds>(now - tick.timestamp).count();
-    latencies.push_back(latency_ns);
+    std::int64_t latency_ns = now - tick.timestamp_ns;
+    out_latencies.record(latency_ns > 0 ? static_cast<std::uint64_t>(latency_ns) : 0);
 }
 
 void TradeEngine::reportStats() {
-    long long sum_latency = 0;
-    long long max_latency = 0;
-    std::map<std::string, int> signal_counts; 
+    std::array<int, kSignalCount> signal_counts{}; 
 
-    for (long long l : latencies) {
-        sum_latency += l;
-        max_latency = std::max(max_latency, l);
+    for (const auto& details : order_details) {
+        signal_counts[static_cast<int>(details.signal)]++;
     }
 
-    for (const auto& order : orders) {
-        signal_counts[order.signal_source]++;
-    }
-
-    long long avg_latency = latencies.empty() ? 0 : sum_latency / latencies.size();
-
     std::cout << "\n--- Performance Report ---\n";
-    std::cout << "Total Market Ticks Processed: " << market_data.size() << "\n";
+    std::cout << "Total Market Ticks Processed: " << ticks_processed << "\n";
     std::cout << "Total Orders Placed:          " << orders.size() << "\n";
     if (!orders.empty()) {
          std::cout << "Orders Breakdown by Signal:\n";
-         for(const auto& pair : signal_counts) {
-             std::cout << "  - " << std::left << std::setw(25) << pair.first + ":" << pair.second << "\n";
+         for (int id = 0; id < kSignalCount; ++id) {
+             if (signal_counts[id] == 0) {
+                 continue;
+             }
+             std::cout << "  - " << std::left << std::setw(25) << std::string(signalName(static_cast<SignalId>(id))) + ":" << signal_counts[id] << "\n";
          }
     }
-    std::cout << "Average Generation-to-Order Latency (ms): " << avg_latency << "\n";
-    std::cout << "Maximum Generation-to-Order Latency (ms): " << max_latency << "\n";
+    std::cout << "Generation-to-Order Latency (ns):\n";
+    latencies.print(std::cout);
 }
 
 // History Management
-void TradeEngine::updateHistory(const MarketData& tick) {
-    auto& prices = price_history[tick.instrument_id];
-    prices.push_back(tick.price);
-    if (prices.size() > 10) {
-        prices.erase(prices.begin());
-    }
-    auto& timestamps = timestamp_history[tick.instrument_id];
-    timestamps.push_back(tick.timestamp);
+void TradeEngine::updateHistory(const MarketData& tick, int index) {
+    price_windows[index].value.push(tick.price());
+    timestamp_windows[index].value.push(tick.timestamp_ns);
 }
 
 double TradeEngine::getAvg(int instrument_id) {
-    auto it = price_history.find(instrument_id);
-    if (it == price_history.end() || it->second.empty()) {
+    int index = instruments.index(instrument_id);
+    if (index < 0 || price_windows[index].value.empty()) {
         return 0.0; 
     }
-    const auto& history = it->second;
-    double sum = std::accumulate(history.begin(), history.end(), 0.0);
-    return sum / history.size();
+    return price_windows[index].value.mean();
 }
 
-// Signals
-// Signal 1: Price thresholds
-TradeEngine::SignalAction TradeEngine::evaluateSignal1(const MarketData& tick) {
-    if (tick.price < 105.0) {
-        return SignalAction::BUY;
-    }
-    if (tick.price > 195.0) {
-        return SignalAction::SELL;
+// Columnar Export
+void TradeEngine::exportTickData(const std::string& filename, bool compress) {
+    std::vector<std::int32_t> ids(market_data.size());
+    std::vector<std::int32_t> prices(market_data.size());
+    std::vector<std::int64_t> timestamps(market_data.size());
+    for (std::size_t i = 0; i < market_data.size(); ++i) {
+        ids[i] = market_data[i].instrument_id;
+        prices[i] = market_data[i].price_ticks;
+        timestamps[i] = market_data[i].timestamp_ns;
     }
-    return SignalAction::NONE;
+    writeColumnarFile(filename, RecordKind::Tick, {
+        {"instrument_id", ColumnType::I32, ids.data()},
+        {"price_ticks", ColumnType::I32, prices.data()},
+        {"timestamp_ns", ColumnType::I64, timestamps.data()},
+    }, market_data.size(), compress);
 }
 
-// Signal 2: Deviation from average
-TradeEngine::SignalAction TradeEngine::evaluateSignal2(const MarketData& tick) {
-    auto it = price_history.find(tick.instrument_id);
-    if (it == price_history.end() || it->second.size() < 5) {
-        return SignalAction::NONE;
+void TradeEngine::exportOrderHistory(const std::string& filename, bool compress) {
+    std::vector<std::int32_t> ids(orders.size());
+    std::vector<std::int32_t> prices(orders.size());
+    std::vector<std::uint8_t> sides(orders.size());
+    std::vector<std::int64_t> timestamps(orders.size());
+    std::vector<std::uint8_t> signals(orders.size());
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        ids[i] = orders[i].instrument_id;
+        prices[i] = orders[i].price_ticks;
+        sides[i] = orders[i].is_buy ? 1 : 0;
+        timestamps[i] = orders[i].timestamp_ns;
+        signals[i] = static_cast<std::uint8_t>(order_details[i].signal);
     }
-    double avg = getAvg(tick.instrument_id);
-    if (avg <= 0) return SignalAction::NONE; 
-
-    if (tick.price < avg * 0.98) {
-        return SignalAction::BUY;
-    }
-    if (tick.price > avg * 1.02) {
-        return SignalAction::SELL;
-    }
-    return SignalAction::NONE;
-}
-
-// Signal 3: Simple momentum
-TradeEngine::SignalAction TradeEngine::evaluateSignal3(const MarketData& tick) {
-    auto it = price_history.find(tick.instrument_id);
-    if (it == price_history.end() || it->second.size() < 3) {
-        return SignalAction::NONE; 
-    }
-
-    const auto& history = it->second;
-
-    double price_t_minus_1 = history[history.size() - 2]; 
-    double price_t_minus_2 = history[history.size() - 3]; 
-
-    if (price_t_minus_1 > price_t_minus_2 && tick.price > price_t_minus_1) {
-        return SignalAction::BUY;
-    }
-
-    return SignalAction::NONE;
+    writeColumnarFile(filename, RecordKind::Order, {
+        {"instrument_id", ColumnType::I32, ids.data()},
+        {"price_ticks", ColumnType::I32, prices.data()},
+        {"is_buy", ColumnType::U8, sides.data()},
+        {"timestamp_ns", ColumnType::I64, timestamps.data()},
+        {"signal", ColumnType::U8, signals.data()},
+    }, orders.size(), compress);
 }
@@ -3,41 +3,83 @@
 
 #include "market_data.h"
 #include "order.h"
+#include "rolling_window.h"
+#include "instrument_registry.h"
+#include "signals.h"
+#include "latency_histogram.h"
+#include "columnar_file.h"
+#include <cstdint>
 #include <random>
 #include <vector>
-#include <unordered_map>
 #include <chrono>
 #include <iostream>
 #include <string> 
 
 class TradeEngine {
 public:
+    // Signal attribution draws from an RNG seeded from the clock, or from
+    // `seed` for runs that must be reproducible
     TradeEngine(const std::vector<MarketData>& feed);
+    TradeEngine(const std::vector<MarketData>& feed, std::uint64_t seed);
 
     void process();
+    // Same strategy with instruments sharded across num_threads workers
+    // (0 = hardware concurrency). Shards own disjoint instruments and run
+    // without locks; their orders are merged in timestamp order at the end.
+    void processParallel(unsigned num_threads = 0);
+    // Runs the strategy over columns read back from a columnar file in event
+    // time: ticks keep their stored timestamps and each order is stamped with
+    // its tick's, so with a seeded engine the same file always yields the
+    // same orders. No latency is recorded; time the replay as a whole.
+    void replay(const TickColumns& ticks);
     void reportStats();
 
-    void exportOrderHistory(const std::string& filename);
-    void exportTickData(const std::string& filename);
+    // Binary columnar exports (see columnar_file.h); throw std::runtime_error
+    // on I/O failure
+    void exportOrderHistory(const std::string& filename, bool compress = false);
+    void exportTickData(const std::string& filename, bool compress = false);
 
 private:
     const std::vector<MarketData>& market_data;
     std::vector<Order> orders;
-    std::vector<long long> latencies;
-    std::unordered_map<int, std::vector<double>> price_history;
-    std::unordered_map<int, std::vector<std::chrono::high_resolution_clock::time_point>> timestamp_history;
+    std::vector<OrderDetails> order_details;  // cold side table, indexed like orders
+    std::size_t ticks_processed = 0;
+    // Generation-to-order latency of every order, in ns
+    LatencyHistogram latencies;
+
+    // Last kHistoryWindow ticks per instrument in fixed-size ring buffers:
+    // memory stays flat however long the session runs
+    static constexpr std::size_t kHistoryWindow = 10;
+    using PriceWindow = RollingWindow<kHistoryWindow>;
+    using TimestampWindow = RingBuffer<std::int64_t, kHistoryWindow>;
+
+    // Per-instrument state as parallel arrays indexed by the registry's dense
+    // index: the price windows the signals read are packed together, and
+    // the timestamps (written every tick, never read by a signal) live apart
+    InstrumentRegistry instruments;
+    std::vector<CacheAligned<PriceWindow>> price_windows;
+    std::vector<CacheAligned<TimestampWindow>> timestamp_windows;
     std::mt19937 random_generator;
     
-    void updateHistory(const MarketData& tick);
+    int registerInstrument(int instrument_id);
+    void updateHistory(const MarketData& tick, int index);
     double getAvg(int instrument_id);
 
-    enum class SignalAction { NONE, BUY, SELL };
+    // Signals voting on every tick; add a policy here to register a new one
+    using ActiveSignals = SignalSet<ThresholdSignal, MeanDeviationSignal, MomentumSignal>;
+
+    // Updates the instrument's windows, votes and places at most one order.
+    // event_time stamps the order with the tick's time instead of the clock
+    // and skips latency recording (replay).
+    void processTick(const MarketData& tick, int index, std::vector<Order>& out_orders,
+                     std::vector<OrderDetails>& out_details, LatencyHistogram& out_latencies, std::mt19937& rng,
+                     bool event_time = false);
 
-    SignalAction evaluateSignal1(const MarketData& tick);
-    SignalAction evaluateSignal2(const MarketData& tick);
-    SignalAction evaluateSignal3(const MarketData& tick);
+    // One of the `count` signals set in mask, uniformly at random
+    static SignalId pickSignal(std::uint32_t mask, int count, std::mt19937& rng);
 
-    void placeOrder(const MarketData& tick, bool is_buy, const std::string& signal_name);
+    static void placeOrder(const MarketData& tick, bool is_buy, SignalId signal, std::vector<Order>& out_orders,
+                           std::vector<OrderDetails>& out_details, LatencyHistogram& out_latencies, bool event_time);
 
 };
 
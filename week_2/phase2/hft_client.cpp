@@ -7,40 +7,51 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <deque>
+#include <cerrno>
+#include <iomanip>
+#include <fcntl.h>
+#include <netinet/tcp.h>
+#include "wire_protocol.h"
+#include "../hw2/latency_histogram.h"
 
 using namespace std;
 
 #define SERVER_IP "127.0.0.1"
 #define SERVER_PORT 12345
 #define BUFFER_SIZE 1024
+#define FAST_BUFFER_SIZE (256 * 1024)
+#define MOMENTUM_WINDOW 3
+
+// Acks arrive on the same stream as prices; each settles one order
+void handleAck(const wire::Ack& ack, int& successfulOrders, int totalOrders) {
+    if (ack.result == wire::AckResult::Won) {
+        successfulOrders++;
+        cout << "🎯 Won price ID " << ack.priceId << " (" << ack.latencyNs << " ns after it was sent)" << endl;
+    } else if (ack.result == wire::AckResult::AlreadyHit) {
+        cout << "🥈 Price ID " << ack.priceId << " was already hit" << endl;
+    } else {
+        cout << "⌛ Price ID " << ack.priceId << " expired" << endl;
+    }
+    double hitPercentage = (static_cast<double>(successfulOrders) / totalOrders) * 100.0;
+    cout << "✅ Orders hit: " << successfulOrders << "/" << totalOrders
+     << " (" << hitPercentage << "%)" << endl;
+}
 
 void receiveAndRespond(int socketFd, const string& name) {
     char buffer[BUFFER_SIZE];
+    string pending;  // partial frame carried over between reads
     int totalOrders=0;
     int successfulOrders=0;
 
     // Send client name
-    send(socketFd, name.c_str(), name.size(), 0);
+    wire::Hello hello = wire::makeHello(name);
+    send(socketFd, &hello, sizeof(hello), 0);
 
-    std::deque<float> priceHistory;
+    std::deque<double> priceHistory;
 
-    while (true) {
-        memset(buffer, 0, BUFFER_SIZE);
-        int bytesReceived = recv(socketFd, buffer, BUFFER_SIZE - 1, 0);
-        if (bytesReceived <= 0) {
-            cerr << "Server closed connection or error occurred." << endl;
-            break;
-        }
-
-        string data(buffer);
-        size_t commaPos = data.find(',');
-        if (commaPos == string::npos) {
-            cerr << "Invalid price format received: " << data << endl;
-            continue;
-        }
-
-        int priceId = stoi(data.substr(0, commaPos));
-        float price = stof(data.substr(commaPos + 1));
+    auto onPrice = [&](const wire::PriceUpdate& update) {
+        uint32_t priceId = update.priceId;
+        double price = update.price;
 
         if (priceHistory.size() >= 3)
             priceHistory.pop_front();
@@ -55,9 +66,9 @@ void receiveAndRespond(int socketFd, const string& name) {
 
         // very simplistic momentum, with no exit criteria
         if (priceHistory.size() == 3) {
-            float a = priceHistory[0];
-            float b = priceHistory[1];
-            float c = priceHistory[2];
+            double a = priceHistory[0];
+            double b = priceHistory[1];
+            double c = priceHistory[2];
         
             bool up = (a < b) && (b < c);
             bool down = (a > b) && (b > c);
@@ -79,8 +90,11 @@ void receiveAndRespond(int socketFd, const string& name) {
            cout << "No momentum. Ignoring price ID " << priceId << endl;
         }
         else {
-            string order = to_string(priceId);
-            send(socketFd, order.c_str(), order.length(), 0);
+            wire::Order order = wire::make<wire::Order>();
+            order.priceId = priceId;
+            order.sentNs = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+            order.side = direction > 0 ? wire::Side::Buy : wire::Side::Sell;
+            send(socketFd, &order, sizeof(order), 0);
 
             string side;
             if (direction > 0){
@@ -92,20 +106,195 @@ void receiveAndRespond(int socketFd, const string& name) {
 
             cout << "📤 Sent " << side << " order for price ID: " << priceId << endl;
             totalOrders++;
-            successfulOrders++;
-            double hitPercentage = (static_cast<double>(successfulOrders) / totalOrders) * 100.0;
-            cout << "✅ Orders hit: " << successfulOrders << "/" << totalOrders
-             << " (" << hitPercentage << "%)" << endl;
+        }
+    };
+
+    while (true) {
+        int bytesReceived = recv(socketFd, buffer, BUFFER_SIZE, 0);
+        if (bytesReceived <= 0) {
+            cerr << "Server closed connection or error occurred." << endl;
+            break;
+        }
+        pending.append(buffer, bytesReceived);
 
+        size_t consumed = wire::forEachFrame(pending.data(), pending.size(),
+                                             [&](wire::MessageType type, const char* frame, size_t length) {
+            if (type == wire::MessageType::PriceUpdate) {
+                wire::PriceUpdate update;
+                if (wire::decode(frame, length, update)) {
+                    onPrice(update);
+                }
+            } else if (type == wire::MessageType::Ack) {
+                wire::Ack ack;
+                if (wire::decode(frame, length, ack)) {
+                    handleAck(ack, successfulOrders, totalOrders);
+                }
+            }
+        });
+        if (consumed == wire::kProtocolError) {
+            cerr << "Invalid message received from server." << endl;
+            break;
         }
+        pending.erase(0, consumed);
     }
 
     close(socketFd);
 }
 
-int main() {
+int64_t steadyNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void recordNs(LatencyHistogram& histogram, int64_t ns) {
+    histogram.record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+}
+
+void printHistogram(const char* label, const LatencyHistogram& histogram) {
+    cout << label << " (ns):\n";
+    histogram.print(cout);
+}
+
+// The last MOMENTUM_WINDOW prices in a fixed ring
+struct PriceWindow {
+    double prices[MOMENTUM_WINDOW] = {};
+    int next = 0;
+    int size = 0;
+
+    void push(double price) {
+        prices[next] = price;
+        next = (next + 1) % MOMENTUM_WINDOW;
+        size = min(size + 1, MOMENTUM_WINDOW);
+    }
+
+    // i = 0 is the oldest price in the window
+    double operator[](int i) const {
+        return prices[(next + MOMENTUM_WINDOW - size + i) % MOMENTUM_WINDOW];
+    }
+};
+
+// Busy-polls a non-blocking socket and reacts to every price as soon as it
+// is parsed: no sleeps, no per-message allocation. Records, per update, the
+// feed latency (server send to receipt) and the batch wait (receipt to the
+// start of parsing that frame, i.e. time spent behind earlier frames of the
+// same read), and per order the reaction time (start of parsing its frame
+// to the order's send returning). All three are printed as histograms, with
+// a stats line every second.
+void runFastClient(int socketFd, const string& name, int durationSec) {
+    static char buffer[FAST_BUFFER_SIZE];
+    size_t filled = 0;
+    int noDelay = 1;
+    setsockopt(socketFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    wire::Hello hello = wire::makeHello(name);
+    send(socketFd, &hello, sizeof(hello), 0);
+    fcntl(socketFd, F_SETFL, fcntl(socketFd, F_GETFL, 0) | O_NONBLOCK);
+
+    PriceWindow window;
+    LatencyHistogram feedLatency;
+    LatencyHistogram batchWait;
+    LatencyHistogram reaction;
+    uint64_t updates = 0, ordersSent = 0, ordersDropped = 0, wins = 0, lost = 0;
+    uint64_t intervalUpdates = 0, intervalOrders = 0;
+    const int64_t startNs = steadyNs();
+    int64_t intervalStartNs = startNs;
+    bool running = true;
+
+    while (running) {
+        ssize_t bytesReceived = recv(socketFd, buffer + filled, FAST_BUFFER_SIZE - filled, 0);
+        int64_t arrivalNs = steadyNs();
+        if (bytesReceived == 0 || (bytesReceived < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            cerr << "Server closed connection or error occurred." << endl;
+            break;
+        }
+
+        if (bytesReceived > 0) {
+            filled += static_cast<size_t>(bytesReceived);
+            size_t consumed = wire::forEachFrame(buffer, filled, [&](wire::MessageType type, const char* frame, size_t length) {
+                if (type == wire::MessageType::Ack) {
+                    wire::Ack ack;
+                    if (wire::decode(frame, length, ack)) {
+                        (ack.result == wire::AckResult::Won ? wins : lost)++;
+                    }
+                    return;
+                }
+                wire::PriceUpdate update;
+                if (type != wire::MessageType::PriceUpdate || !wire::decode(frame, length, update)) {
+                    return;
+                }
+                int64_t frameNs = steadyNs();
+                updates++;
+                intervalUpdates++;
+                recordNs(feedLatency, arrivalNs - update.sentNs);
+                recordNs(batchWait, frameNs - arrivalNs);
+
+                // very simplistic momentum, with no exit criteria
+                window.push(update.price);
+                if (window.size < MOMENTUM_WINDOW) {
+                    return;
+                }
+                double a = window[0];
+                double b = window[1];
+                double c = window[2];
+                bool up = (a < b) && (b < c);
+                bool down = (a > b) && (b > c);
+                if (!up && !down) {
+                    return;
+                }
+
+                wire::Order order = wire::make<wire::Order>();
+                order.priceId = update.priceId;
+                order.sentNs = steadyNs();
+                order.side = up ? wire::Side::Buy : wire::Side::Sell;
+                if (send(socketFd, &order, sizeof(order), MSG_DONTWAIT | MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(order))) {
+                    recordNs(reaction, steadyNs() - frameNs);
+                    ordersSent++;
+                    intervalOrders++;
+                } else {
+                    ordersDropped++;  // socket full: a late order is worthless
+                }
+            });
+            if (consumed == wire::kProtocolError) {
+                cerr << "Invalid message received from server." << endl;
+                break;
+            }
+            memmove(buffer, buffer + consumed, filled - consumed);
+            filled -= consumed;
+        } else {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+
+        if (arrivalNs - intervalStartNs >= 1000000000) {
+            double seconds = (arrivalNs - intervalStartNs) / 1e9;
+            cout << "📈 " << static_cast<uint64_t>(intervalUpdates / seconds) << " updates/s, "
+                 << static_cast<uint64_t>(intervalOrders / seconds) << " orders/s, reaction p50 "
+                 << reaction.percentile(50) << " ns, p99 " << reaction.percentile(99) << " ns, batch wait p99 "
+                 << batchWait.percentile(99) << " ns" << endl;
+            intervalStartNs = arrivalNs;
+            intervalUpdates = 0;
+            intervalOrders = 0;
+            running = durationSec <= 0 || arrivalNs - startNs < durationSec * 1000000000ll;
+        }
+    }
+
+    cout << "\n--- " << name << " ---" << endl;
+    cout << "Updates received: " << updates << ", orders sent: " << ordersSent << " (" << ordersDropped
+         << " dropped), won: " << wins << ", lost: " << lost << endl;
+    printHistogram("Feed latency (server send to receipt)", feedLatency);
+    printHistogram("Batch wait (receipt to frame parse)", batchWait);
+    printHistogram("Reaction (frame parse to order sent)", reaction);
+    close(socketFd);
+}
+
+int main(int argc, char* argv[]) {
     srand(time(nullptr));
 
+    // hft_client [--fast [SECONDS]]: --fast runs the busy-poll client,
+    // for SECONDS if given, otherwise until the server disconnects
+    bool fast = argc > 1 && strcmp(argv[1], "--fast") == 0;
+    int durationSec = fast && argc > 2 ? atoi(argv[2]) : 0;
+
     string name;
     cout << "Enter your client name: ";
     getline(cin, name);
@@ -127,6 +316,10 @@ int main() {
     }
 
     cout << "✅ Connected to server at " << SERVER_IP << ":" << SERVER_PORT << endl;
-    receiveAndRespond(sock, name);
+    if (fast) {
+        runFastClient(sock, name, durationSec);
+    } else {
+        receiveAndRespond(sock, name);
+    }
     return 0;
 }
@@ -3,114 +3,570 @@
 #include <mutex>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 #include <chrono>
 #include <atomic>
+#include <memory>
+#include <string>
 #include <cstring>
 #include <cstdlib>
+#include <cerrno>
 #include <unistd.h>
+#include <fcntl.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
 #include <utility>
+#include <algorithm>
+#include "wire_protocol.h"
 
 using namespace std;
 using namespace std::chrono;
 
 #define PORT 12345
-#define BUFFER_SIZE 1024
+#define BUFFER_SIZE (64 * 1024)
+#define MAX_REACTOR_THREADS 4
+#define MAX_EVENTS 256
+// Bytes a client may have queued before it stops receiving price updates
+#define MAX_OUTPUT_BUFFER (256 * 1024)
+// Price ids are arbitrated in a ring of this many slots (a power of two); a
+// slot is reused PRICE_SLOTS broadcasts later, after which late orders for
+// the old id count as expired
+#define PRICE_SLOTS (64 * 1024)
+#ifndef BROADCAST_INTERVAL_MS
+#define BROADCAST_INTERVAL_MS 5000
+#endif
+
+// Command-line options. rate 0 keeps the classic mode of one logged update
+// every BROADCAST_INTERVAL_MS; a positive rate publishes that many updates
+// per second from a busy-wait pacer, in batches of at most `batch`, and
+// prints stats every statsMs.
+struct ServerConfig {
+    double rate = 0;
+    int batch = 1024;
+    int statsMs = 1000;
+};
+
+ServerConfig config;
 
-struct ClientInfo {
+// One client socket, owned by exactly one reactor thread
+struct Connection {
     int socket;
+    uint32_t clientNumber;  // 1-based, unique for the server's lifetime
     string name;
-    thread clientThread;
+    bool registered = false;
+    string input;           // partial frame left over from the last read
+    string output;          // bytes accepted for sending but not yet written
+    size_t outputSent = 0;  // prefix of output already written
+    size_t droppedUpdates = 0;
+};
+
+// Edge-triggered epoll loop over a share of the connections. Other threads
+// never touch its connections: they post new sockets and outgoing price
+// messages to the inbox and wake it through an eventfd.
+struct Reactor {
+    int epollFd = -1;
+    int wakeFd = -1;
+    unordered_map<int, unique_ptr<Connection>> connections;
+
+    mutex inboxMutex;
+    vector<pair<int, uint32_t>> newSockets;  // socket, client number
+    vector<shared_ptr<const string>> outgoing;
+
+    // Written only by the reactor thread, summed by the stats printer
+    struct Counters {
+        atomic<uint64_t> updatesQueued{0};  // price updates accepted for sending, over all clients
+        atomic<uint64_t> ordersWon{0};
+        atomic<uint64_t> ordersExpired{0};
+    } counters;
+
+    // Per-client backlog, refreshed by the reactor in high-rate mode and
+    // read by the stats printer under inboxMutex
+    struct ClientLag {
+        string name;
+        size_t backlogBytes;
+        size_t droppedUpdates;
+    };
+    vector<ClientLag> lagSnapshot;
+    int64_t lastSnapshotNs = 0;
+
+    thread worker;
 };
 
-vector<unique_ptr<ClientInfo>> clients;
-mutex clientsMutex;
+vector<unique_ptr<Reactor>> reactors;
+atomic<int> connectedClients{0};
 
-unordered_map<int, steady_clock::time_point> priceTimestamps;
-unordered_set<int> priceAlreadyHit;
-mutex priceMutex;
+// First-hit arbitration state of one price id. `state` packs the id (high
+// 32 bits) with the winning client number (low 32 bits, 0 while unhit), so
+// a single CAS both checks that the slot still holds the id and claims it.
+struct alignas(64) PriceSlot {
+    atomic<uint64_t> state{~0ull};  // no id yet
+    atomic<int64_t> sentAtNs{0};
+};
+
+PriceSlot priceSlots[PRICE_SLOTS];
 
 atomic<int> priceId{0};
 
-// Send new price every 5 seconds
-void broadcastPrices() {
-    while (true) {
-        int id = priceId++;
-        float price = 100.0f + (rand() % 1000) / 10.0f;
+uint64_t slotState(int id, uint32_t winner) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(id)) << 32) | winner;
+}
 
-        string message = to_string(id) + "," + to_string(price);
+PriceSlot& slotFor(int id) {
+    return priceSlots[static_cast<uint32_t>(id) % PRICE_SLOTS];
+}
 
-        {
-            lock_guard<mutex> lock(priceMutex);
-            priceTimestamps[id] = steady_clock::now();
-        }
+int64_t steadyNs() {
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
 
-        {
-            lock_guard<mutex> lock(clientsMutex);
-            for (auto& client : clients) {
-                send(client->socket, message.c_str(), message.size(), 0);
+void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+void wake(Reactor& reactor) {
+    uint64_t one = 1;
+    ssize_t written = write(reactor.wakeFd, &one, sizeof(one));
+    (void)written;  // the counter saturating still leaves the reactor woken
+}
+
+void closeConnection(Reactor& reactor, int fd) {
+    auto it = reactor.connections.find(fd);
+    if (it == reactor.connections.end()) {
+        return;
+    }
+    cerr << "❌ Client " << it->second->name << " disconnected." << endl;
+    epoll_ctl(reactor.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    reactor.connections.erase(it);
+    connectedClients--;
+}
+
+// Writes as much queued output as the socket takes without blocking.
+// Returns false if the connection failed and was closed.
+bool flushOutput(Reactor& reactor, Connection& conn) {
+    while (conn.outputSent < conn.output.size()) {
+        ssize_t sent = send(conn.socket, conn.output.data() + conn.outputSent, conn.output.size() - conn.outputSent,
+                            MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;  // EPOLLOUT resumes the flush
             }
+            closeConnection(reactor, conn.socket);
+            return false;
         }
+        conn.outputSent += static_cast<size_t>(sent);
+    }
+    if (conn.outputSent == conn.output.size()) {
+        conn.output.clear();
+        conn.outputSent = 0;
+    } else if (conn.outputSent > conn.output.size() / 2) {
+        conn.output.erase(0, conn.outputSent);
+        conn.outputSent = 0;
+    }
+    return true;
+}
 
-        cout << "📢 Sent price ID " << id << " with value " << price << endl;
-        this_thread::sleep_for(chrono::seconds(5));
+// Queues a batch of price updates without writing it. A client whose
+// backlog is over MAX_OUTPUT_BUFFER misses updates until it catches up, so
+// it never holds up the others.
+void queueUpdates(Reactor& reactor, Connection& conn, const string& batch) {
+    if (conn.output.size() - conn.outputSent + batch.size() > MAX_OUTPUT_BUFFER) {
+        if (conn.droppedUpdates++ == 0) {
+            cerr << "🐢 Client " << conn.name << " is too slow, dropping updates." << endl;
+        }
+        return;
     }
+    conn.output += batch;
+    reactor.counters.updatesQueued.fetch_add(batch.size() / sizeof(wire::PriceUpdate), memory_order_relaxed);
 }
 
-// Handle a client connection
-void handleClient(ClientInfo* client) {
-    char buffer[BUFFER_SIZE];
+// Wait-free: one CAS decides the winner, with no lock shared between
+// reactors and no per-id allocation. The result is queued as an ack.
+// Classic mode logs every win and expired id; in high-rate mode they are
+// only counted, for the stats line, to keep console writes off this path.
+void handleOrder(Reactor& reactor, Connection& conn, const wire::Order& order) {
+    int receivedPriceId = static_cast<int>(order.priceId);
+    int64_t now = steadyNs();
+
+    wire::Ack ack = wire::make<wire::Ack>();
+    ack.priceId = order.priceId;
+    ack.result = wire::AckResult::AlreadyHit;
+
+    PriceSlot& slot = slotFor(receivedPriceId);
+    uint64_t expected = slotState(receivedPriceId, 0);
+    if (!slot.state.compare_exchange_strong(expected, slotState(receivedPriceId, conn.clientNumber),
+                                            memory_order_acq_rel, memory_order_acquire)) {
+        if (expected >> 32 != static_cast<uint32_t>(receivedPriceId)) {
+            if (config.rate > 0) {
+                reactor.counters.ordersExpired.fetch_add(1, memory_order_relaxed);
+            } else {
+                cerr << "⚠️ Unknown or expired price ID: " << receivedPriceId << endl;
+            }
+            ack.result = wire::AckResult::Expired;
+        }
+        // Otherwise already hit by another client
+        wire::append(conn.output, ack);
+        return;
+    }
 
-    // Receive client name
-    memset(buffer, 0, BUFFER_SIZE);
-    int bytesReceived = recv(client->socket, buffer, BUFFER_SIZE - 1, 0);
-    if (bytesReceived <= 0) {
-        cerr << "❌ Failed to receive client name." << endl;
-        close(client->socket);
+    int64_t latency = now - slot.sentAtNs.load(memory_order_relaxed);
+    ack.result = wire::AckResult::Won;
+    ack.latencyNs = latency;
+    wire::append(conn.output, ack);
+    if (config.rate > 0) {
+        reactor.counters.ordersWon.fetch_add(1, memory_order_relaxed);
         return;
     }
+    cout << "🎯 " << conn.name << " hit price ID " << receivedPriceId
+         << " after " << latency << " ns" << endl;
+}
 
-    client->name = string(buffer);
-    cout << "👤 Registered client: " << client->name << endl;
+// Dispatches every complete frame in data; false on a protocol violation
+bool handleFrames(Reactor& reactor, Connection& conn, const char* data, size_t size, size_t& consumed) {
+    bool valid = true;
+    consumed = wire::forEachFrame(data, size, [&](wire::MessageType type, const char* frame, size_t length) {
+        if (type == wire::MessageType::Hello && !conn.registered) {
+            wire::Hello hello;
+            if (!wire::decode(frame, length, hello)) {
+                valid = false;
+                return;
+            }
+            conn.name = wire::helloName(hello);
+            conn.registered = true;
+            cout << "👤 Registered client: " << conn.name << endl;
+        } else if (type == wire::MessageType::Order) {
+            wire::Order order;
+            if (!wire::decode(frame, length, order)) {
+                valid = false;
+                return;
+            }
+            handleOrder(reactor, conn, order);
+        }
+        // Anything else is not meant for the server and is skipped
+    });
+    return valid && consumed != wire::kProtocolError;
+}
 
-    // Receive orders
+// Reads until the socket is drained (required with edge triggering).
+// Frames are parsed in place in the receive buffer; only a trailing partial
+// frame is copied aside. Acks are written once the socket is drained.
+void handleReadable(Reactor& reactor, Connection& conn) {
+    static thread_local char buffer[BUFFER_SIZE];
+    size_t queuedBefore = conn.output.size() - conn.outputSent;
     while (true) {
-        memset(buffer, 0, BUFFER_SIZE);
-        bytesReceived = recv(client->socket, buffer, BUFFER_SIZE - 1, 0);
-        if (bytesReceived <= 0) {
-            cerr << "❌ Client " << client->name << " disconnected." << endl;
+        ssize_t bytesReceived = recv(conn.socket, buffer, BUFFER_SIZE, 0);
+        if (bytesReceived < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesReceived < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
             break;
         }
+        if (bytesReceived <= 0) {
+            closeConnection(reactor, conn.socket);
+            return;
+        }
+
+        size_t consumed = 0;
+        bool valid;
+        if (conn.input.empty()) {
+            valid = handleFrames(reactor, conn, buffer, static_cast<size_t>(bytesReceived), consumed);
+            if (valid) {
+                conn.input.assign(buffer + consumed, static_cast<size_t>(bytesReceived) - consumed);
+            }
+        } else {
+            conn.input.append(buffer, static_cast<size_t>(bytesReceived));
+            valid = handleFrames(reactor, conn, conn.input.data(), conn.input.size(), consumed);
+            if (valid) {
+                conn.input.erase(0, consumed);
+            }
+        }
+        if (!valid) {
+            cerr << "⚠️ Malformed message from " << conn.name << ", closing connection." << endl;
+            closeConnection(reactor, conn.socket);
+            return;
+        }
+    }
+    if (queuedBefore == 0 && conn.output.size() > conn.outputSent) {
+        flushOutput(reactor, conn);
+    }
+}
+
+void drainInbox(Reactor& reactor) {
+    uint64_t count;
+    while (read(reactor.wakeFd, &count, sizeof(count)) > 0) {
+    }
 
-        int receivedPriceId = atoi(buffer);
-        steady_clock::time_point now = steady_clock::now();
+    vector<pair<int, uint32_t>> sockets;
+    vector<shared_ptr<const string>> messages;
+    {
+        lock_guard<mutex> lock(reactor.inboxMutex);
+        sockets.swap(reactor.newSockets);
+        messages.swap(reactor.outgoing);
+    }
 
-        {
-            lock_guard<mutex> lock(priceMutex);
-            if (priceAlreadyHit.count(receivedPriceId)) {
-                // Already hit by another client
-                continue;
+    for (auto [fd, clientNumber] : sockets) {
+        auto conn = make_unique<Connection>();
+        conn->socket = fd;
+        conn->clientNumber = clientNumber;
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.fd = fd;
+        if (epoll_ctl(reactor.epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            perror("epoll_ctl failed");
+            close(fd);
+            connectedClients--;
+            continue;
+        }
+        reactor.connections.emplace(fd, std::move(conn));
+    }
+
+    if (messages.empty()) {
+        return;
+    }
+
+    // Every update posted since the last wake-up goes out in one write per
+    // client
+    string batch;
+    for (const auto& message : messages) {
+        batch += *message;
+    }
+    // Collect first: a failed write closes and erases the connection
+    vector<Connection*> targets;
+    targets.reserve(reactor.connections.size());
+    for (auto& entry : reactor.connections) {
+        targets.push_back(entry.second.get());
+    }
+    for (Connection* conn : targets) {
+        bool idle = conn->output.size() == conn->outputSent;
+        queueUpdates(reactor, *conn, batch);
+        if (idle) {
+            flushOutput(reactor, *conn);
+        }
+    }
+
+    if (config.rate > 0) {
+        int64_t now = steadyNs();
+        if (now - reactor.lastSnapshotNs >= config.statsMs * 500000ll) {
+            vector<Reactor::ClientLag> snapshot;
+            snapshot.reserve(reactor.connections.size());
+            for (auto& entry : reactor.connections) {
+                const Connection& conn = *entry.second;
+                snapshot.push_back({conn.name, conn.output.size() - conn.outputSent, conn.droppedUpdates});
             }
+            lock_guard<mutex> lock(reactor.inboxMutex);
+            reactor.lagSnapshot.swap(snapshot);
+            reactor.lastSnapshotNs = now;
+        }
+    }
+}
 
-            if (priceTimestamps.find(receivedPriceId) == priceTimestamps.end()) {
-                cerr << "⚠️ Unknown price ID: " << receivedPriceId << endl;
+void runReactor(Reactor* reactor) {
+    epoll_event events[MAX_EVENTS];
+    while (true) {
+        int ready = epoll_wait(reactor->epollFd, events, MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
                 continue;
             }
+            perror("epoll_wait failed");
+            return;
+        }
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == reactor->wakeFd) {
+                drainInbox(*reactor);
+                continue;
+            }
+            auto it = reactor->connections.find(fd);
+            if (it == reactor->connections.end()) {
+                continue;  // closed earlier in this batch
+            }
+            Connection& conn = *it->second;
+            if (events[i].events & EPOLLOUT) {
+                if (!flushOutput(*reactor, conn)) {
+                    continue;
+                }
+            }
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                handleReadable(*reactor, conn);
+            }
+        }
+    }
+}
 
-            priceAlreadyHit.insert(receivedPriceId);
-            auto latency = duration_cast<milliseconds>(now - priceTimestamps[receivedPriceId]).count();
-            cout << "🎯 " << client->name << " hit price ID " << receivedPriceId
-                 << " after " << latency << " ms" << endl;
+// Publishes one update per price under consecutive ids, posting them to
+// every reactor as a single message. Returns the first id. Updates carry
+// the steady_clock send time in ns so local clients can measure fan-out
+// latency.
+int publishUpdates(const double* prices, int count) {
+    int firstId = priceId.fetch_add(count);
+    int64_t sentAtNs = steadyNs();
+    auto message = make_shared<string>();
+    message->reserve(static_cast<size_t>(count) * sizeof(wire::PriceUpdate));
+    wire::PriceUpdate update = wire::make<wire::PriceUpdate>();
+    for (int i = 0; i < count; ++i) {
+        int id = firstId + i;
+        // Open the id's slot before any client can see the price: the send
+        // time first, then the id (release) that makes the slot hittable
+        PriceSlot& slot = slotFor(id);
+        slot.sentAtNs.store(sentAtNs, memory_order_relaxed);
+        slot.state.store(slotState(id, 0), memory_order_release);
+
+        update.priceId = static_cast<uint32_t>(id);
+        update.sentNs = sentAtNs;
+        update.price = prices[i];
+        wire::append(*message, update);
+    }
+    for (auto& reactor : reactors) {
+        {
+            lock_guard<mutex> lock(reactor->inboxMutex);
+            reactor->outgoing.push_back(message);
         }
+        wake(*reactor);
+    }
+    return firstId;
+}
+
+// Send new price every BROADCAST_INTERVAL_MS
+void broadcastPrices() {
+    while (true) {
+        double price = 100.0f + (rand() % 1000) / 10.0f;
+        int id = publishUpdates(&price, 1);
+
+        cout << "📢 Sent price ID " << id << " with value " << price
+             << " to " << connectedClients.load() << " clients" << endl;
+        this_thread::sleep_for(chrono::milliseconds(BROADCAST_INTERVAL_MS));
     }
+}
+
+// Totals of every reactor's counters
+struct RateTotals {
+    uint64_t updatesQueued = 0;
+    uint64_t ordersWon = 0;
+    uint64_t ordersExpired = 0;
+};
 
-    close(client->socket);
+RateTotals sumCounters() {
+    RateTotals totals;
+    for (auto& reactor : reactors) {
+        totals.updatesQueued += reactor->counters.updatesQueued.load(memory_order_relaxed);
+        totals.ordersWon += reactor->counters.ordersWon.load(memory_order_relaxed);
+        totals.ordersExpired += reactor->counters.ordersExpired.load(memory_order_relaxed);
+    }
+    return totals;
+}
+
+void printRateStats(double seconds, uint64_t published, uint64_t skipped, const RateTotals& delta) {
+    vector<Reactor::ClientLag> lags;
+    for (auto& reactor : reactors) {
+        lock_guard<mutex> lock(reactor->inboxMutex);
+        lags.insert(lags.end(), reactor->lagSnapshot.begin(), reactor->lagSnapshot.end());
+    }
+    sort(lags.begin(), lags.end(), [](const Reactor::ClientLag& a, const Reactor::ClientLag& b) {
+        return a.backlogBytes > b.backlogBytes;
+    });
+
+    cout << "📊 " << static_cast<long long>(published / seconds) << " updates/s (target "
+         << static_cast<long long>(config.rate) << ", " << skipped << " skipped), fan-out "
+         << static_cast<long long>(delta.updatesQueued / seconds) << " msgs/s to "
+         << connectedClients.load() << " clients, orders " << delta.ordersWon << " won / "
+         << delta.ordersExpired << " expired" << endl;
+    // Lag is the client's server-side backlog, in updates and in time at
+    // the target rate
+    for (size_t i = 0; i < lags.size() && i < 5; ++i) {
+        double backlogUpdates = static_cast<double>(lags[i].backlogBytes) / sizeof(wire::PriceUpdate);
+        cout << "   " << lags[i].name << ": backlog " << static_cast<long long>(backlogUpdates) << " updates ("
+             << backlogUpdates / config.rate * 1000.0 << " ms), " << lags[i].droppedUpdates << " dropped" << endl;
+    }
+}
+
+// Paces config.rate updates/sec against steady_clock deadlines: sleeps
+// while the next deadline is far off, then busy-waits for it. Updates
+// that fell due together go out as one batch; if publishing falls more
+// than 100 ms behind, the missed deadlines are skipped instead of burst.
+void broadcastAtRate() {
+    const double periodNs = 1e9 / config.rate;
+    const uint64_t maxBehind = max<uint64_t>(config.batch, static_cast<uint64_t>(config.rate / 10));
+    const int64_t startNs = steadyNs();
+    vector<double> prices(config.batch);
+    double price = 150.0;
+    uint64_t random = 0x9e3779b97f4a7c15ull;
+
+    uint64_t scheduled = 0;  // deadlines consumed, published or skipped
+    uint64_t published = 0;
+    uint64_t skipped = 0;
+    int64_t statsStartNs = startNs;
+    uint64_t statsPublished = 0;
+    uint64_t statsSkipped = 0;
+    RateTotals statsTotals;
+
+    while (true) {
+        int64_t now = steadyNs();
+        uint64_t due = static_cast<uint64_t>((now - startNs) / periodNs) + 1;
+        if (due <= scheduled) {
+            double waitNs = startNs + scheduled * periodNs - now;
+            if (waitNs > 200000) {
+                this_thread::sleep_for(nanoseconds(static_cast<int64_t>(waitNs) - 100000));
+            } else {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+            }
+            continue;
+        }
+
+        uint64_t behind = due - scheduled;
+        if (behind > maxBehind) {
+            skipped += behind - config.batch;
+            scheduled += behind - config.batch;
+            behind = config.batch;
+        }
+        int count = static_cast<int>(min<uint64_t>(behind, config.batch));
+        for (int i = 0; i < count; ++i) {
+            // xorshift64 random walk, reflected into [100, 200]
+            random ^= random << 13;
+            random ^= random >> 7;
+            random ^= random << 17;
+            price += (static_cast<double>(random >> 11) / 9007199254740992.0 - 0.5) * 0.1;
+            price = price < 100.0 ? 200.0 - price : (price > 200.0 ? 400.0 - price : price);
+            prices[i] = price;
+        }
+        publishUpdates(prices.data(), count);
+        scheduled += count;
+        published += count;
+
+        if (now - statsStartNs >= config.statsMs * 1000000ll) {
+            RateTotals totals = sumCounters();
+            RateTotals delta{totals.updatesQueued - statsTotals.updatesQueued, totals.ordersWon - statsTotals.ordersWon,
+                             totals.ordersExpired - statsTotals.ordersExpired};
+            printRateStats((now - statsStartNs) / 1e9, published - statsPublished, skipped - statsSkipped, delta);
+            statsStartNs = now;
+            statsPublished = published;
+            statsSkipped = skipped;
+            statsTotals = totals;
+        }
+    }
+}
+
+// Allow as many open sockets as the hard limit permits
+void raiseFileLimit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
 }
 
 // Start the server
 void startServer() {
+    raiseFileLimit();
+
     int serverSocket = socket(AF_INET, SOCK_STREAM, 0);
     if (serverSocket < 0) {
         perror("Socket creation failed");
@@ -131,50 +587,98 @@ void startServer() {
         exit(EXIT_FAILURE);
     }
 
-    if (listen(serverSocket, 5) < 0) {
+    if (listen(serverSocket, SOMAXCONN) < 0) {
         perror("Listen failed");
         close(serverSocket);
         exit(EXIT_FAILURE);
     }
 
     cout << "🚀 Server is listening on 127.0.0.1:" << PORT << endl;
+    if (config.rate > 0) {
+        cout << "⚡ Publishing " << static_cast<long long>(config.rate) << " updates/s in batches of up to "
+             << config.batch << endl;
+    }
+
+    // A fixed set of reactor threads serves every client
+    unsigned reactorCount = max(1u, min<unsigned>(MAX_REACTOR_THREADS, thread::hardware_concurrency()));
+    for (unsigned i = 0; i < reactorCount; ++i) {
+        auto reactor = make_unique<Reactor>();
+        reactor->epollFd = epoll_create1(0);
+        reactor->wakeFd = eventfd(0, EFD_NONBLOCK);
+        if (reactor->epollFd < 0 || reactor->wakeFd < 0) {
+            perror("Reactor setup failed");
+            exit(EXIT_FAILURE);
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLET;
+        ev.data.fd = reactor->wakeFd;
+        epoll_ctl(reactor->epollFd, EPOLL_CTL_ADD, reactor->wakeFd, &ev);
+        reactors.push_back(std::move(reactor));
+    }
+    for (auto& reactor : reactors) {
+        reactor->worker = thread(runReactor, reactor.get());
+        reactor->worker.detach();
+    }
 
-    thread priceThread(broadcastPrices);
+    thread priceThread(config.rate > 0 ? broadcastAtRate : broadcastPrices);
     priceThread.detach();
 
+    size_t nextReactor = 0;
+    uint32_t nextClientNumber = 1;
     while (true) {
         sockaddr_in clientAddr{};
         socklen_t clientLen = sizeof(clientAddr);
         int clientSocket = accept(serverSocket, (sockaddr*)&clientAddr, &clientLen);
         if (clientSocket < 0) {
             perror("Accept failed");
+            if (errno == EMFILE || errno == ENFILE) {
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
             continue;
         }
 
         cout << "📡 Client connected: " << inet_ntoa(clientAddr.sin_addr) << endl;
 
-        // Create a new client object on the heap
-        auto client = make_unique<ClientInfo>();
-        client->socket = clientSocket;
-
-        // Store a pointer before moving ownership
-        ClientInfo* clientPtr = client.get();
+        setNonBlocking(clientSocket);
+        int noDelay = 1;
+        setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        connectedClients++;
 
+        // Hand the socket to the reactors round-robin
+        Reactor& reactor = *reactors[nextReactor];
+        nextReactor = (nextReactor + 1) % reactors.size();
         {
-            lock_guard<mutex> lock(clientsMutex);
-            clients.push_back(std::move(client));
+            lock_guard<mutex> lock(reactor.inboxMutex);
+            reactor.newSockets.emplace_back(clientSocket, nextClientNumber++);
         }
-
-        // Launch the thread with raw pointer (safe because we hold it in the vector)
-        thread t(handleClient, clientPtr);
-        t.detach();
-        clientPtr->clientThread = std::move(t);  // Optional
+        wake(reactor);
     }
 
     close(serverSocket);
 }
 
-int main() {
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [--rate UPDATES_PER_SEC] [--batch N] [--stats-ms MS]" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--rate") == 0) {
+            config.rate = atof(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--batch") == 0) {
+            config.batch = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--stats-ms") == 0) {
+            config.statsMs = atoi(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (config.rate < 0 || config.batch < 1 || config.statsMs < 1) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
     startServer();
     return 0;
 }
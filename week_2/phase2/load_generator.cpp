@@ -0,0 +1,212 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include "wire_protocol.h"
+
+using namespace std;
+using namespace std::chrono;
+
+#define SERVER_IP "127.0.0.1"
+#define SERVER_PORT 12345
+#define BUFFER_SIZE 4096
+#define MAX_EVENTS 1024
+
+// Opens many passive clients against hft_server and measures how long each
+// price update takes to reach each of them. The server stamps every update
+// with its steady_clock time, which is CLOCK_MONOTONIC and so comparable
+// across processes on the same machine.
+//
+// Measurement starts with the first update published after every client
+// has received something, i.e. once the server has registered them all.
+// The run ends when every measured update has reached every client, or at
+// the deadline, when whatever arrived is reported with its client count.
+// In --rate mode the server drops updates to backlogged clients, so an
+// update may never reach everyone; expect such runs to end at the deadline.
+//
+// Usage: load_generator [clients=1000] [updates=3] [deadline_s=30]
+
+struct LoadClient {
+    int socket;
+    string pending;  // partial frame carried over between reads
+    bool sawUpdate;
+};
+
+struct UpdateStats {
+    vector<int64_t> latencies;  // ns from send to receipt, one per client
+    int64_t firstArrival = 0;
+    int64_t lastArrival = 0;
+};
+
+int64_t nowNs() {
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void raiseFileLimit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+int64_t percentile(vector<int64_t>& values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+    nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+int main(int argc, char* argv[]) {
+    int numClients = argc > 1 ? atoi(argv[1]) : 1000;
+    int numUpdates = argc > 2 ? atoi(argv[2]) : 3;
+    int deadlineSeconds = argc > 3 ? atoi(argv[3]) : 30;
+    raiseFileLimit();
+
+    sockaddr_in serverAddr{};
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(SERVER_PORT);
+    inet_pton(AF_INET, SERVER_IP, &serverAddr.sin_addr);
+
+    int epollFd = epoll_create1(0);
+    vector<LoadClient> clients;
+    clients.reserve(numClients);
+    for (int i = 0; i < numClients; ++i) {
+        int sock = socket(AF_INET, SOCK_STREAM, 0);
+        if (sock < 0 || connect(sock, (sockaddr*)&serverAddr, sizeof(serverAddr)) < 0) {
+            cerr << "Connection " << i << " failed: " << strerror(errno) << endl;
+            return 1;
+        }
+        wire::Hello hello = wire::makeHello("load-" + to_string(i));
+        send(sock, &hello, sizeof(hello), 0);
+        fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+
+        clients.push_back({sock, "", false});
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLET;
+        ev.data.u32 = static_cast<uint32_t>(i);
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, sock, &ev);
+    }
+    cout << "✅ Connected " << numClients << " clients, waiting for " << numUpdates << " updates" << endl;
+
+    // connect() returns before the server has handed the socket to a
+    // reactor, so updates published meanwhile miss some clients. Only ids
+    // above every id seen by the time the last client got its first update
+    // are measured.
+    int clientsSeen = 0;
+    int highestIdSeen = -1;
+    int firstMeasuredId = -1;
+    vector<UpdateStats> updates(numUpdates);
+    int completed = 0;
+    epoll_event events[MAX_EVENTS];
+    char buffer[BUFFER_SIZE];
+    const int64_t deadline = nowNs() + static_cast<int64_t>(deadlineSeconds) * 1000000000;
+
+    while (completed < numUpdates) {
+        int64_t remainingMs = (deadline - nowNs()) / 1000000;
+        if (remainingMs <= 0) {
+            break;
+        }
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, static_cast<int>(remainingMs));
+        if (ready < 0 && errno != EINTR) {
+            perror("epoll_wait failed");
+            return 1;
+        }
+        for (int e = 0; e < ready; ++e) {
+            LoadClient& client = clients[events[e].data.u32];
+            while (true) {
+                ssize_t bytesReceived = recv(client.socket, buffer, BUFFER_SIZE, 0);
+                if (bytesReceived < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (bytesReceived <= 0) {
+                    if (bytesReceived == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                        cerr << "Server closed a connection." << endl;
+                        return 1;
+                    }
+                    break;
+                }
+                int64_t arrival = nowNs();
+                client.pending.append(buffer, bytesReceived);
+
+                size_t consumed = wire::forEachFrame(client.pending.data(), client.pending.size(),
+                                                     [&](wire::MessageType type, const char* frame, size_t length) {
+                    wire::PriceUpdate update;
+                    if (type != wire::MessageType::PriceUpdate || !wire::decode(frame, length, update)) {
+                        return;
+                    }
+                    int id = static_cast<int>(update.priceId);
+                    highestIdSeen = max(highestIdSeen, id);
+                    if (!client.sawUpdate) {
+                        client.sawUpdate = true;
+                        if (++clientsSeen == numClients) {
+                            firstMeasuredId = highestIdSeen + 1;
+                        }
+                    }
+                    if (firstMeasuredId < 0) {
+                        return;
+                    }
+                    int slot = id - firstMeasuredId;
+                    if (slot < 0 || slot >= numUpdates) {
+                        return;
+                    }
+                    UpdateStats& stats = updates[slot];
+                    if (stats.latencies.empty()) {
+                        stats.firstArrival = arrival;
+                    }
+                    stats.lastArrival = max(stats.lastArrival, arrival);
+                    stats.latencies.push_back(arrival - update.sentNs);
+                    if (stats.latencies.size() == clients.size()) {
+                        completed++;
+                    }
+                });
+                if (consumed == wire::kProtocolError) {
+                    cerr << "Invalid message received from server." << endl;
+                    return 1;
+                }
+                client.pending.erase(0, consumed);
+            }
+        }
+    }
+
+    if (firstMeasuredId < 0) {
+        cerr << "Deadline reached after " << deadlineSeconds << " s: only " << clientsSeen << " of " << numClients
+             << " clients received an update, nothing measured." << endl;
+        return 1;
+    }
+    if (completed < numUpdates) {
+        cout << "⚠️ Deadline reached after " << deadlineSeconds << " s: " << completed << " of " << numUpdates
+             << " updates reached every client" << endl;
+    }
+
+    cout << "\n--- Fan-out latency, " << numClients << " clients (us) ---\n";
+    for (int u = 0; u < numUpdates; ++u) {
+        UpdateStats& stats = updates[u];
+        cout << "Price ID " << firstMeasuredId + u << ": reached " << stats.latencies.size() << "/" << numClients;
+        if (!stats.latencies.empty()) {
+            cout << ", p50 " << percentile(stats.latencies, 50) / 1000
+                 << ", p99 " << percentile(stats.latencies, 99) / 1000
+                 << ", max " << *max_element(stats.latencies.begin(), stats.latencies.end()) / 1000
+                 << ", first-to-last arrival " << (stats.lastArrival - stats.firstArrival) / 1000;
+        }
+        cout << endl;
+    }
+
+    for (LoadClient& client : clients) {
+        close(client.socket);
+    }
+    close(epollFd);
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "wire_protocol.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Compares the original "id,price" text messages with the binary protocol
+// in wire_protocol.h: encode rate, parse cost per message, and messages/sec
+// through a local stream socket with the receiver parsing everything.
+//
+// Usage: protocol_benchmark [messages=1000000]
+
+#define CHUNK_SIZE (64 * 1024)
+
+struct Result {
+    double seconds;
+    double checksum;  // keeps the work observable
+};
+
+double priceFor(int i) {
+    return 100.0 + (i * 7919 % 1000) / 10.0;
+}
+
+string encodeText(int count) {
+    string out;
+    for (int i = 0; i < count; ++i) {
+        out += to_string(i) + "," + to_string(priceFor(i)) + "\n";
+    }
+    return out;
+}
+
+string encodeBinary(int count) {
+    string out;
+    out.reserve(static_cast<size_t>(count) * sizeof(wire::PriceUpdate));
+    wire::PriceUpdate update = wire::make<wire::PriceUpdate>();
+    for (int i = 0; i < count; ++i) {
+        update.priceId = static_cast<uint32_t>(i);
+        update.sentNs = i;
+        update.price = priceFor(i);
+        wire::append(out, update);
+    }
+    return out;
+}
+
+// Parses like the original client: copy the message, split at the comma,
+// stoi/stof on substring copies. Lines stand in for the framing it lacked.
+// Returns bytes consumed; a trailing partial line is left.
+size_t parseText(const char* data, size_t size, double& checksum) {
+    size_t start = 0;
+    while (true) {
+        const char* newline = static_cast<const char*>(memchr(data + start, '\n', size - start));
+        if (!newline) {
+            return start;
+        }
+        string message(data + start, newline);
+        start = static_cast<size_t>(newline - data) + 1;
+        size_t commaPos = message.find(',');
+        if (commaPos == string::npos) {
+            continue;
+        }
+        int priceId = stoi(message.substr(0, commaPos));
+        float price = stof(message.substr(commaPos + 1));
+        checksum += priceId + price;
+    }
+}
+
+size_t parseBinary(const char* data, size_t size, double& checksum) {
+    return wire::forEachFrame(data, size, [&](wire::MessageType, const char* frame, size_t length) {
+        wire::PriceUpdate update;
+        if (wire::decode(frame, length, update)) {
+            checksum += update.priceId + update.price;
+        }
+    });
+}
+
+template <typename Fn>
+double timeIt(Fn&& fn) {
+    auto start = steady_clock::now();
+    fn();
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+// Streams `encoded` through a socketpair in CHUNK_SIZE writes while this
+// thread receives and parses it
+template <typename Parser>
+Result streamThroughSocket(const string& encoded, Parser parse) {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+        perror("socketpair failed");
+        exit(EXIT_FAILURE);
+    }
+    Result result{0, 0};
+    result.seconds = timeIt([&]() {
+        thread sender([&]() {
+            for (size_t offset = 0; offset < encoded.size();) {
+                ssize_t sent = send(fds[0], encoded.data() + offset, min<size_t>(CHUNK_SIZE, encoded.size() - offset), 0);
+                if (sent <= 0) {
+                    break;
+                }
+                offset += static_cast<size_t>(sent);
+            }
+            shutdown(fds[0], SHUT_WR);
+        });
+        vector<char> buffer(2 * CHUNK_SIZE);
+        size_t filled = 0;
+        while (true) {
+            ssize_t received = recv(fds[1], buffer.data() + filled, buffer.size() - filled, 0);
+            if (received <= 0) {
+                break;
+            }
+            filled += static_cast<size_t>(received);
+            size_t consumed = parse(buffer.data(), filled, result.checksum);
+            if (consumed > filled) {
+                cerr << "Malformed stream." << endl;
+                exit(EXIT_FAILURE);
+            }
+            memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+            filled -= consumed;
+        }
+        sender.join();
+    });
+    close(fds[0]);
+    close(fds[1]);
+    return result;
+}
+
+void report(const char* label, int count, size_t bytes, double encodeSeconds, double parseSeconds, const Result& streamed) {
+    cout << left << setw(8) << label << right
+         << setw(10) << fixed << setprecision(1) << static_cast<double>(bytes) / count << " B/msg"
+         << setw(10) << count / encodeSeconds / 1e6 << " M enc/s"
+         << setw(10) << parseSeconds * 1e9 / count << " ns/parse"
+         << setw(10) << count / streamed.seconds / 1e6 << " M msg/s streamed" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    string text;
+    string binary;
+    double textEncode = timeIt([&]() { text = encodeText(count); });
+    double binaryEncode = timeIt([&]() { binary = encodeBinary(count); });
+
+    double textChecksum = 0;
+    double binaryChecksum = 0;
+    double textParse = timeIt([&]() { parseText(text.data(), text.size(), textChecksum); });
+    double binaryParse = timeIt([&]() { parseBinary(binary.data(), binary.size(), binaryChecksum); });
+
+    Result textStream = streamThroughSocket(text, parseText);
+    Result binaryStream = streamThroughSocket(binary, parseBinary);
+
+    cout << "--- " << count << " price updates ---" << endl;
+    report("text", count, text.size(), textEncode, textParse, textStream);
+    report("binary", count, binary.size(), binaryEncode, binaryParse, binaryStream);
+    cout << "(checksums " << textChecksum + textStream.checksum << " / "
+         << binaryChecksum + binaryStream.checksum << ")" << endl;
+    return 0;
+}
@@ -0,0 +1,148 @@
+#ifndef WIRE_PROTOCOL_H
+#define WIRE_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Binary protocol spoken between hft_server and its clients.
+//
+// Every message is one frame: a 4-byte header (total frame length in bytes,
+// message type, protocol version) followed by a fixed-layout body. All
+// fields are little-endian and naturally aligned, so a frame is read with
+// one memcpy straight out of the receive buffer and written by appending
+// the struct's bytes. TCP may split or merge frames; forEachFrame() walks
+// the complete frames at the front of a buffer and leaves the rest.
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "wire_protocol.h assumes a little-endian host"
+#endif
+
+namespace wire {
+
+constexpr uint8_t kVersion = 1;
+constexpr size_t kNameLength = 28;
+// forEachFrame() result for a malformed stream
+constexpr size_t kProtocolError = SIZE_MAX;
+
+enum class MessageType : uint8_t {
+    Hello = 1,        // client -> server, once, first
+    PriceUpdate = 2,  // server -> client
+    Order = 3,        // client -> server
+    Ack = 4           // server -> client, one per order
+};
+
+enum class Side : uint8_t { Buy = 1, Sell = 2 };
+
+enum class AckResult : uint8_t {
+    Won = 0,         // first hit on the price
+    AlreadyHit = 1,  // another client was first
+    Expired = 2      // unknown id, or its slot was reused
+};
+
+struct FrameHeader {
+    uint16_t length;
+    MessageType type;
+    uint8_t version;
+};
+
+struct Hello {
+    static constexpr MessageType kType = MessageType::Hello;
+    FrameHeader header;
+    char name[kNameLength];  // NUL-padded
+};
+
+struct PriceUpdate {
+    static constexpr MessageType kType = MessageType::PriceUpdate;
+    FrameHeader header;
+    uint32_t priceId;
+    int64_t sentNs;  // server steady_clock at send
+    double price;
+};
+
+struct Order {
+    static constexpr MessageType kType = MessageType::Order;
+    FrameHeader header;
+    uint32_t priceId;
+    int64_t sentNs;  // client steady_clock at send
+    Side side;
+    uint8_t reserved[7];
+};
+
+struct Ack {
+    static constexpr MessageType kType = MessageType::Ack;
+    FrameHeader header;
+    uint32_t priceId;
+    int64_t latencyNs;  // price send to order receipt, for a win
+    AckResult result;
+    uint8_t reserved[7];
+};
+
+static_assert(sizeof(FrameHeader) == 4, "frame header layout");
+static_assert(sizeof(Hello) == 32, "Hello layout");
+static_assert(sizeof(PriceUpdate) == 24 && offsetof(PriceUpdate, sentNs) == 8, "PriceUpdate layout");
+static_assert(sizeof(Order) == 24 && offsetof(Order, side) == 16, "Order layout");
+static_assert(sizeof(Ack) == 24 && offsetof(Ack, result) == 16, "Ack layout");
+
+// A zeroed message with its header filled in
+template <typename Msg>
+Msg make() {
+    Msg msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.header.length = static_cast<uint16_t>(sizeof(Msg));
+    msg.header.type = Msg::kType;
+    msg.header.version = kVersion;
+    return msg;
+}
+
+inline Hello makeHello(const std::string& name) {
+    Hello msg = make<Hello>();
+    std::memcpy(msg.name, name.data(), name.size() < kNameLength ? name.size() : kNameLength - 1);
+    return msg;
+}
+
+inline std::string helloName(const Hello& msg) {
+    return std::string(msg.name, strnlen(msg.name, kNameLength));
+}
+
+template <typename Msg>
+void append(std::string& out, const Msg& msg) {
+    out.append(reinterpret_cast<const char*>(&msg), sizeof(Msg));
+}
+
+// Copies a frame of the right size into msg; false if the size is wrong
+template <typename Msg>
+bool decode(const char* frame, size_t length, Msg& msg) {
+    if (length != sizeof(Msg)) {
+        return false;
+    }
+    std::memcpy(&msg, frame, sizeof(Msg));
+    return true;
+}
+
+// Calls handler(type, frame, length) for each complete frame at the front
+// of data, in order, without copying. Returns the bytes consumed (a partial
+// trailing frame is left for the next call), or kProtocolError if a frame
+// is shorter than its header or from another protocol version.
+template <typename Handler>
+size_t forEachFrame(const char* data, size_t size, Handler&& handler) {
+    size_t offset = 0;
+    while (size - offset >= sizeof(FrameHeader)) {
+        FrameHeader header;
+        std::memcpy(&header, data + offset, sizeof(header));
+        if (header.length < sizeof(FrameHeader) || header.version != kVersion) {
+            return kProtocolError;
+        }
+        if (size - offset < header.length) {
+            break;
+        }
+        handler(header.type, data + offset, static_cast<size_t>(header.length));
+        offset += header.length;
+    }
+    return offset;
+}
+
+}  // namespace wire
+
+#endif
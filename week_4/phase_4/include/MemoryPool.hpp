@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include "huge_pages.h"
 
 // not a template class, so implementation in .cpp file
 
@@ -9,6 +10,10 @@ public:
     // Constructor
     MemoryPool(std::size_t blockSize, std::size_t poolSize);
 
+    // Pool backed by its own mapping: 2MB pages for large pools, optionally
+    // pre-faulted and mlocked so the hot path never page-faults
+    MemoryPool(std::size_t blockSize, std::size_t poolSize, const HugePageOptions& pages);
+
     // Destructor
     ~MemoryPool();
 
@@ -19,9 +24,12 @@ public:
     void deallocate(void* pointer);
 
 private:
+    void buildFreeList();
+
     void* pool;            // Raw memory for the pool
     void** freeList;       // Linked list of free blocks
     std::size_t blockSize; // Size of each block
     std::size_t poolSize;  // Number of blocks in the pool
+    bool mapped = false;   // pool came from huge_page_allocate
 };
 
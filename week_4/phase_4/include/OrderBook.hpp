@@ -7,6 +7,7 @@
 #include <map>
 #include <unordered_map>
 #include <string>
+#include <optional>
 
 template <typename PriceType,
           typename OrderIdType,
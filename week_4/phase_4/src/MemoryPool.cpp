@@ -13,7 +13,23 @@ MemoryPool::MemoryPool(std::size_t blockSize_param,
 {
     // 1) Allocate one big chunk
     pool = ::operator new(blockSize * poolSize);
+    buildFreeList();
+}
 
+MemoryPool::MemoryPool(std::size_t blockSize_param,
+                       std::size_t poolSize_param,
+                       const HugePageOptions& pages)
+    : pool(nullptr),
+      freeList(nullptr),
+      blockSize(blockSize_param),
+      poolSize(poolSize_param),
+      mapped(true)
+{
+    pool = huge_page_allocate(blockSize * poolSize, pages);
+    buildFreeList();
+}
+
+void MemoryPool::buildFreeList() {
     // 2) Carve it into a singly‐linked free list
     auto  buffer = static_cast<char*>(pool);
     for (std::size_t i = 0; i < poolSize; ++i) {
@@ -32,7 +48,11 @@ MemoryPool::MemoryPool(std::size_t blockSize_param,
 
 // Destructor: tear down the pool
 MemoryPool::~MemoryPool() {
-    ::operator delete(pool);
+    if (mapped) {
+        huge_page_deallocate(pool, blockSize * poolSize);
+    } else {
+        ::operator delete(pool);
+    }
 }
 
 // Allocate one block; pop from free list
@@ -13,6 +13,7 @@
 #include <numeric>
 #include <cmath>
 #include <iomanip>
+#include <cstring>
 
 using namespace std::chrono;
 
@@ -140,6 +141,35 @@ public:
         unaligned_latencies = latencies;
         analyzeLatencies(latencies, "Unaligned MarketData Test");
     }
+
+    // Allocate-and-fill latency of a heap-backed pool vs. one pre-faulted
+    // mapping on 2MB pages
+    void runMemoryPoolTest(size_t numBlocks) {
+        std::cout << "\nRunning MemoryPool test with " << numBlocks << " blocks...\n";
+        MemoryPool heapPool(sizeof(OrderType), numBlocks);
+        MemoryPool hugePool(sizeof(OrderType), numBlocks, HugePageOptions{HugePageMode::Transparent, true, false});
+        analyzeLatencies(allocateAll(heapPool, numBlocks), "Heap MemoryPool allocate");
+        analyzeLatencies(allocateAll(hugePool, numBlocks), "Huge-page MemoryPool allocate");
+    }
+
+    static std::vector<long long> allocateAll(MemoryPool& pool, size_t numBlocks) {
+        std::vector<long long> latencies;
+        std::vector<void*> blocks;
+        latencies.reserve(numBlocks);
+        blocks.reserve(numBlocks);
+        for (size_t i = 0; i < numBlocks; ++i) {
+            auto start = high_resolution_clock::now();
+            void* block = pool.allocate();
+            std::memset(block, static_cast<int>(i), sizeof(OrderType));
+            auto end = high_resolution_clock::now();
+            latencies.push_back(duration_cast<nanoseconds>(end - start).count());
+            blocks.push_back(block);
+        }
+        for (void* block : blocks) {
+            pool.deallocate(block);
+        }
+        return latencies;
+    }
     
       void analyzeLatencies(const std::vector<long long>& latencies, const std::string& testName) {
         if (latencies.empty()) return;
@@ -185,6 +215,8 @@ int main() {
         tester.runUnalignedTest(ticks);
        
     }
+
+    tester.runMemoryPoolTest(1000000);
     
     return 0;
 }
@@ -7,10 +7,13 @@
 #include <memory>   
 #include <iostream>  
 
-template <typename T>
+// Alloc decides where the slots live, e.g. HugePageAllocator<T> from
+// alignment.h (week_1/phase1, on the Makefile's include path) to keep a
+// large pool on 2MB pages
+template <typename T, typename Alloc = std::allocator<T>>
 class ObjectPool {
 private:
-    std::vector<T> pool_;
+    std::vector<T, Alloc> pool_;
     std::list<size_t> free_indices_; 
     size_t capacity_;
     size_t used_count_;
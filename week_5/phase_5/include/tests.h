@@ -29,6 +29,7 @@ void test_optimized_modify_nonexistent();
 void test_optimized_delete_nonexistent();
 void test_optimized_invalid_params();
 void test_optimized_pool_exhaustion();
+void test_object_pool_huge_pages();
 
 void stress_test_original_book(OrderBook& book, int num_operations, bool verbose = false);
 void stress_test_optimized_book(OptimizedOrderBook& book, int num_operations, bool verbose = false);
@@ -5,10 +5,14 @@
 #include <cassert>   
 #include <stdexcept> 
 #include <iomanip>   
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
 
 #include "../include/orderbook.h"
 #include "../include/optimized_orderbook.h"
 #include "../include/tests.h"
+#include "alignment.h"
 
 
 #define RUN_TEST(test_function) \
@@ -304,6 +308,27 @@ void test_optimized_pool_exhaustion() {
     assert(!book.getOrder("O2", o));
 }
 
+void test_object_pool_huge_pages() {
+    // Over 1MB of slots, so the storage is one 2MB-aligned mapping
+    const size_t capacity = 50000;
+    ObjectPool<OrderOpt, HugePageAllocator<OrderOpt>> pool(capacity);
+    assert(pool.capacity() == capacity);
+
+    std::vector<OrderOpt*> orders;
+    for (size_t i = 0; i < capacity; ++i) {
+        orders.push_back(pool.allocate("H" + std::to_string(i), 100.0 + i, 1, i % 2 == 0));
+    }
+    assert(reinterpret_cast<std::uintptr_t>(orders.front()) % kHugePageSize == 0);
+    assert(pool.free_count() == 0);
+    assert(orders.back()->id == "H" + std::to_string(capacity - 1));
+
+    for (OrderOpt* order : orders) {
+        pool.deallocate(order);
+    }
+    assert(pool.used_count() == 0);
+    assert(pool.free_count() == capacity);
+}
+
 struct StressOp {
     enum Type { ADD, MODIFY, DELETE } type;
     std::string id;
@@ -466,6 +491,7 @@ void run_all_unit_tests() {
     RUN_TEST(test_optimized_delete_nonexistent);
     RUN_TEST(test_optimized_invalid_params);
     RUN_TEST(test_optimized_pool_exhaustion);
+    RUN_TEST(test_object_pool_huge_pages);
     std::cout << "===== OptimizedOrderBook Unit Tests Complete =====" << std::endl;
 }
 